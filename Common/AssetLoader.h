@@ -0,0 +1,342 @@
+/*
+ *  Carga de assets em segundo plano: a janela abre e o loop de renderização
+ *  começa na hora, e cada asset aparece quando fica pronto.
+ *
+ *  Cada asset passa por três etapas:
+ *    1. decode  - numa thread do WorkerPool (ThreadPool.h): leitura do .obj,
+ *                 cache binário, decodificação de imagens...; sem OpenGL;
+ *    2. upload  - numa thread própria com um contexto OpenGL compartilhado com
+ *                 a janela (janela invisível criada em start()): glBufferData,
+ *                 glTexSubImage...; no fim, glFenceSync + glFlush;
+ *    3. finish  - na thread principal, dentro de poll(), depois que a fence
+ *                 foi sinalizada: o que não é compartilhado entre contextos
+ *                 (VAOs) e a marcação do asset como pronto.
+ *  Buffers, texturas e fences são compartilhados entre os contextos; VAOs não.
+ *  Se o contexto compartilhado não puder ser criado, o upload roda em poll(),
+ *  no máximo AssetLoader::kMainThreadUploads por frame.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  AssetLoader loader;
+ *  loader.start(run, window);            // depois do gladLoadGLLoader
+ *  std::shared_ptr<AsyncMesh> suzanne = loader.loadMesh("../assets/Modelos3D/Suzanne.obj");
+ *  while (runShouldContinue(window, run)) {
+ *      loader.poll();
+ *      if (suzanne->ready())
+ *          drawMesh(suzanne->mesh);
+ *      ...
+ *  }
+ *  loader.stop();                        // antes de destruir a janela
+ *  destroyMesh(suzanne->mesh);
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+#include "MeshCache.h"
+#include "ObjLoader.h"
+#include "RunMode.h"
+#include "ThreadPool.h"
+
+enum class AssetState { Queued, Decoding, Uploading, Ready, Failed };
+
+// Estado comum dos assets; só leia os dados (mesh, textura) depois de ready()
+struct Asset
+{
+    std::string path;
+    std::atomic<AssetState> state{AssetState::Queued};
+    double readyMs = -1.0;      // ms entre o pedido e o fim do finish (ou da falha)
+
+    virtual ~Asset() {}
+    bool ready() const { return state == AssetState::Ready; }
+    bool failed() const { return state == AssetState::Failed; }
+};
+
+struct AsyncMesh : Asset
+{
+    Mesh mesh;
+};
+
+class AssetLoader
+{
+public:
+    static const int kMainThreadUploads = 1;
+
+    ~AssetLoader() { stop(); }
+
+    // Chamar na thread principal, com o contexto da janela ativo.
+    // `workers` = threads de decode (0 = todos os núcleos menos um)
+    bool start(RunConfig& run, GLFWwindow* window, int workers = 0)
+    {
+        if (workerPool)
+            return true;
+
+        // Janela invisível só para ter um segundo contexto no mesmo grupo de
+        // compartilhamento (usa os hints de versão que o programa já definiu)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        uploadWindow = createRunWindow(run, "upload", window);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+        glfwMakeContextCurrent(window);
+        if (!uploadWindow)
+            std::cerr << "Aviso: sem contexto compartilhado; os uploads vao rodar na thread principal" << std::endl;
+
+        if (workers <= 0)
+            workers = std::max(1, resolveThreadCount(0) - 1);
+        workerPool.reset(new WorkerPool(workers));
+        stopping = false;
+        if (uploadWindow)
+            uploader = std::thread([this]() { uploadLoop(); });
+        return true;
+    }
+
+    // Cancela o que ainda não foi enviado e espera as threads. Uploads já
+    // feitos são concluídos (finish), para que o dono possa liberar os objetos;
+    // os decodificados sem upload viram Failed e os que nem começaram ficam Queued
+    void stop()
+    {
+        if (!workerPool)
+            return;
+
+        workerPool->stop();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (uploader.joinable())
+            uploader.join();
+        if (uploadWindow) {
+            glfwDestroyWindow(uploadWindow);
+            uploadWindow = NULL;
+        }
+        workerPool.reset();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::shared_ptr<Job>& job : uploads)
+            job->asset->state = AssetState::Failed;
+        uploads.clear();
+        for (std::shared_ptr<Job>& job : done) {
+            if (job->fence) {
+                glClientWaitSync(job->fence, GL_SYNC_FLUSH_COMMANDS_BIT, (GLuint64)1000000000);
+                glDeleteSync(job->fence);
+                job->finish();
+                job->asset->state = AssetState::Ready;
+            } else {
+                job->asset->state = AssetState::Failed;
+            }
+        }
+        done.clear();
+        pendingCount = 0;
+    }
+
+    // Asset genérico. `decode` roda num worker, `upload` com um contexto
+    // OpenGL ativo (compartilhado ou o principal) e `finish` na thread
+    // principal; decode/upload retornam false em caso de erro
+    void submit(std::shared_ptr<Asset> asset, std::function<bool()> decode, std::function<bool()> upload,
+                std::function<void()> finish)
+    {
+        std::shared_ptr<Job> job = std::make_shared<Job>();
+        job->asset = asset;
+        job->decode = std::move(decode);
+        job->upload = std::move(upload);
+        job->finish = std::move(finish);
+        job->start = Clock::now();
+        pendingCount++;
+
+        workerPool->submit([this, job]() {
+            job->asset->state = AssetState::Decoding;
+            bool ok = job->decode();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ok) {
+                job->asset->state = AssetState::Uploading;
+                uploads.push_back(job);
+            } else {
+                done.push_back(job);    // sem fence: falhou
+            }
+            wake.notify_all();
+        });
+    }
+
+    // .obj indexado (loadCachedOBJ com `useCache`, senão loadIndexedOBJ)
+    std::shared_ptr<AsyncMesh> loadMesh(const std::string& filePATH, const ObjLoadOptions& options = ObjLoadOptions(),
+                                        bool useCache = true)
+    {
+        struct Decoded
+        {
+            std::unique_ptr<MeshCacheFile> cache;
+            std::vector<GLfloat> vBuffer;
+            std::vector<GLuint> indices;
+            MaterialGroups groups;
+            std::vector<MeshLod> lods;
+            std::vector<Meshlet> meshlets;
+        };
+
+        std::shared_ptr<AsyncMesh> asset = std::make_shared<AsyncMesh>();
+        asset->path = filePATH;
+        std::shared_ptr<Decoded> data = std::make_shared<Decoded>();
+
+        auto decode = [=]() {
+            std::string cachePath = meshCachePath(filePATH);
+            if (useCache) {
+                data->cache.reset(new MeshCacheFile());
+                if (data->cache->open(cachePath, filePATH, meshCacheFlags(options), objVertexFormat(options)))
+                    return true;
+                data->cache.reset();
+            }
+            if (!parseIndexedOBJ(filePATH, data->vBuffer, data->indices, options, &data->groups, &data->lods,
+                                 &data->meshlets))
+                return false;
+            if (useCache && !writeMeshCache(cachePath, filePATH, data->vBuffer, data->indices, options, &data->groups,
+                                            &data->lods, &data->meshlets))
+                std::cerr << "Aviso: nao foi possivel gravar o cache " << cachePath << std::endl;
+            return true;
+        };
+        auto upload = [=]() {
+            if (data->cache) {
+                data->cache->uploadBuffers(asset->mesh, options.streams);
+            } else {
+                asset->mesh.lods = data->lods;
+                asset->mesh.meshlets = data->meshlets;
+                uploadIndexedMeshBuffers(data->vBuffer, data->indices, asset->mesh, options);
+                asset->mesh.groups = data->groups;
+            }
+            // Os dados de CPU não são mais necessários
+            *data = Decoded();
+            return true;
+        };
+        auto finish = [asset]() { createMeshVertexArrays(asset->mesh); };
+
+        submit(asset, decode, upload, finish);
+        return asset;
+    }
+
+    // Chamar uma vez por frame na thread principal. Conclui os assets cujo
+    // upload já terminou na GPU (sem esperar) e retorna quantos ficaram prontos
+    int poll()
+    {
+        if (!workerPool)
+            return 0;
+
+        if (!uploadWindow) {
+            for (int i = 0; i < kMainThreadUploads; i++) {
+                std::shared_ptr<Job> job;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (uploads.empty())
+                        break;
+                    job = uploads.front();
+                    uploads.pop_front();
+                }
+                runUpload(job);
+            }
+        }
+
+        std::vector<std::shared_ptr<Job>> finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.swap(done);
+        }
+
+        int readyCount = 0;
+        std::vector<std::shared_ptr<Job>> waiting;
+        for (std::shared_ptr<Job>& job : finished) {
+            if (job->fence) {
+                GLenum status = glClientWaitSync(job->fence, 0, 0);
+                if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                    waiting.push_back(job);
+                    continue;
+                }
+                glDeleteSync(job->fence);
+                job->finish();
+                job->asset->state = AssetState::Ready;
+                readyCount++;
+            } else {
+                job->asset->state = AssetState::Failed;
+            }
+            job->asset->readyMs = std::chrono::duration<double, std::milli>(Clock::now() - job->start).count();
+            pendingCount--;
+        }
+
+        if (!waiting.empty()) {
+            std::lock_guard<std::mutex> lock(mutex);
+            done.insert(done.begin(), waiting.begin(), waiting.end());
+        }
+        return readyCount;
+    }
+
+    // Assets pedidos que ainda não ficaram prontos nem falharam
+    int pending() const { return pendingCount; }
+    bool sharedContext() const { return uploadWindow != NULL; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Job
+    {
+        std::shared_ptr<Asset> asset;
+        std::function<bool()> decode;
+        std::function<bool()> upload;
+        std::function<void()> finish;
+        GLsync fence = 0;
+        Clock::time_point start;
+    };
+
+    // Roda o upload no contexto ativo e cria a fence que poll() consulta
+    void runUpload(const std::shared_ptr<Job>& job)
+    {
+        if (job->upload()) {
+            job->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            // Sem o flush, a fence poderia nunca chegar à GPU vista de outro contexto
+            glFlush();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        done.push_back(job);
+    }
+
+    void uploadLoop()
+    {
+        glfwMakeContextCurrent(uploadWindow);
+        for (;;) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return stopping || !uploads.empty(); });
+                if (stopping)
+                    break;
+                job = uploads.front();
+                uploads.pop_front();
+            }
+            runUpload(job);
+        }
+        glfwMakeContextCurrent(NULL);
+    }
+
+    std::unique_ptr<WorkerPool> workerPool;
+    GLFWwindow* uploadWindow = NULL;
+    std::thread uploader;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<Job>> uploads;   // decodificados, esperando upload
+    std::vector<std::shared_ptr<Job>> done;     // enviados (com fence) ou que falharam
+    bool stopping = false;
+    std::atomic<int> pendingCount{0};
+};
@@ -0,0 +1,165 @@
+/*
+ *  Círculos preenchidos desenhados por instância: um círculo unitário só
+ *  (TRIANGLE_FAN com o centro e `segments` + 1 pontos da borda, montado uma vez)
+ *  e um VBO de instâncias com centro, raio e cor de cada círculo (16 bytes).
+ *  Todos os círculos saem numa chamada de glDrawArraysInstanced, em vez de um
+ *  VAO/VBO e um glDrawArrays por círculo.
+ *
+ *  As posições estão no mesmo espaço dos exercícios ([-1, 1] na tela).
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  CircleRenderer circles;
+ *  circles.init(36);
+ *  circles.add(glm::vec2(-0.55f, -0.55f), 0.15f, glm::vec3(0.0f));    // roda esquerda
+ *  circles.add(glm::vec2(0.55f, -0.55f), 0.15f, glm::vec3(0.0f));     // roda direita
+ *  ...
+ *  circles.draw();                 // envia as instâncias só se mudaram
+ *  ...
+ *  circles.destroy();
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.h"
+#include "VertexFormat.h"
+
+// Uma instância do VBO
+struct CircleInstance
+{
+    glm::vec2 center;
+    float radius;
+    uint32_t color;         // RGBA8
+};
+
+const char* const kCircleVertexShader = "#version 460 core\n"
+"layout (location = 0) in vec2 aUnit;\n"      // ponto do círculo unitário
+"layout (location = 1) in vec3 aCircle;\n"    // centro xy, raio z
+"layout (location = 2) in vec4 aColor;\n"
+"out vec4 ourColor;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aCircle.xy + aUnit * aCircle.z, 0.0, 1.0);\n"
+"   ourColor = aColor;\n"
+"}\0";
+
+const char* const kCircleFragmentShader = "#version 460 core\n"
+"in vec4 ourColor;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = ourColor;\n"
+"}\0";
+
+class CircleRenderer
+{
+public:
+    // Precisa do contexto ativo (compila o programa e monta o círculo unitário)
+    bool init(int segments = 36)
+    {
+        program = compileShaderProgram(kCircleVertexShader, kCircleFragmentShader);
+        if (!program)
+            return false;
+
+        std::vector<GLfloat> unit;
+        unit.push_back(0.0f);
+        unit.push_back(0.0f);
+        for (int i = 0; i <= segments; i++) {
+            float theta = 2.0f * 3.1415926f * float(i) / float(segments);
+            unit.push_back(cosf(theta));
+            unit.push_back(sinf(theta));
+        }
+        vertexCount = (GLsizei)(unit.size() / 2);
+
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &unitVBO);
+        glGenBuffers(1, &instanceVBO);
+        glBindVertexArray(VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, unitVBO);
+        glBufferData(GL_ARRAY_BUFFER, unit.size() * sizeof(GLfloat), unit.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*)0);
+        glEnableVertexAttribArray(0);
+
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        const GLsizei stride = sizeof(CircleInstance);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(CircleInstance, center));
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid*)offsetof(CircleInstance, color));
+        for (GLuint location = 1; location <= 2; location++) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+        glBindVertexArray(0);
+        return true;
+    }
+
+    // Retorna o índice da instância (para set)
+    size_t add(glm::vec2 center, float radius, glm::vec3 color, float alpha = 1.0f)
+    {
+        instances.push_back(CircleInstance());
+        set(instances.size() - 1, center, radius, color, alpha);
+        return instances.size() - 1;
+    }
+
+    void set(size_t index, glm::vec2 center, float radius, glm::vec3 color, float alpha = 1.0f)
+    {
+        CircleInstance& c = instances[index];
+        c.center = center;
+        c.radius = radius;
+        c.color = vertexpack::packRGBA8(glm::vec4(color, alpha));
+        dirty = true;
+    }
+
+    void clear()
+    {
+        instances.clear();
+        dirty = true;
+    }
+
+    size_t size() const { return instances.size(); }
+
+    // Uma chamada para todos os círculos
+    void draw()
+    {
+        if (instances.empty())
+            return;
+        if (dirty) {
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(CircleInstance), instances.data(), GL_DYNAMIC_DRAW);
+            dirty = false;
+        }
+        glUseProgram(program);
+        glBindVertexArray(VAO);
+        glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, vertexCount, (GLsizei)instances.size());
+        glBindVertexArray(0);
+    }
+
+    void destroy()
+    {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &unitVBO);
+        glDeleteBuffers(1, &instanceVBO);
+        glDeleteProgram(program);
+        VAO = unitVBO = instanceVBO = program = 0;
+    }
+
+private:
+    std::vector<CircleInstance> instances;
+    GLuint program = 0;
+    GLuint VAO = 0;
+    GLuint unitVBO = 0;
+    GLuint instanceVBO = 0;
+    GLsizei vertexCount = 0;
+    bool dirty = true;
+};
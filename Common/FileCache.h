@@ -0,0 +1,81 @@
+/*
+ *  Peças comuns dos caches em disco (MeshCache.h, TextureCache.h,
+ *  ProgramCache.h): hash do conteúdo, alinhamento dos blocos no arquivo e
+ *  tamanho/data do arquivo de origem, usados para decidir se um cache ainda
+ *  corresponde ao que o gerou.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "MappedFile.h"
+
+// Os blocos de dados dos caches começam em múltiplos de 16 bytes
+const uint32_t kFileCacheAlignment = 16;
+
+inline uint64_t alignFileCache(uint64_t offset)
+{
+    return (offset + kFileCacheAlignment - 1) / kFileCacheAlignment * kFileCacheAlignment;
+}
+
+// Hash de 64 bits do conteúdo (8 bytes por passo; não é criptográfico)
+inline uint64_t hashBytes(const char* data, size_t size)
+{
+    const uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    uint64_t h = 0xCBF29CE484222325ull ^ (size * kMul);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        h = (h ^ w) * kMul;
+        h ^= h >> 29;
+    }
+    for (; i < size; i++)
+        h = (h ^ (unsigned char)data[i]) * 0x100000001B3ull;
+    return h ^ (h >> 32);
+}
+
+// Tamanho e data de modificação do arquivo de origem de um cache
+struct FileCacheSource
+{
+    uint64_t size = 0;
+    int64_t time = 0;
+};
+
+inline bool statCacheSource(const std::string& path, FileCacheSource& source)
+{
+    std::error_code ec;
+    source.size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return false;
+    source.time = (int64_t)std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    return !ec;
+}
+
+inline uint64_t hashCacheSource(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return 0;
+    return hashBytes(file.data(), file.size());
+}
+
+// Grava a data nova da origem no cabeçalho de um cache que continua valendo
+// (só a data mudou, o hash é o mesmo: git checkout, cópia...), para as
+// próximas cargas não calcularem o hash de novo. Se falhar, o cache vale assim mesmo
+inline bool updateCacheSourceTime(const std::string& cachePath, size_t offset, int64_t time)
+{
+    std::fstream file(cachePath.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.seekp((std::streamoff)offset);
+    file.write((const char*)&time, sizeof(time));
+    return file.good();
+}
@@ -0,0 +1,249 @@
+/*
+ *  Medição de tempo de frame para os exercícios.
+ *
+ *  Descarta os primeiros frames (aquecimento: compilação de shaders, upload de
+ *  buffers, caches frios) e guarda uma amostra por frame medido em cada série:
+ *    frame  intervalo entre o início de um frame e o início do próximo
+ *    cpu    trabalho de CPU do frame (até antes da troca de buffers)
+ *    swap   tempo gasto na troca de buffers (glfwSwapBuffers / glFinish)
+ *  Outras séries (ex.: tempos de GPU por passada) podem ser adicionadas com addSample.
+ *
+ *  Ao final imprime min/média/p50/p95/p99/max de cada série e, se houver um
+ *  caminho de saída, grava em JSON (.json) ou CSV (qualquer outra extensão).
+ *
+ *  Normalmente é usado através do RunMode.h (--profile arquivo --warmup N).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct FrameStats
+{
+    size_t samples = 0;
+    double min = 0.0, mean = 0.0, p50 = 0.0, p95 = 0.0, p99 = 0.0, max = 0.0;
+};
+
+// Percentis pelo método "nearest rank"
+inline FrameStats computeFrameStats(std::vector<double> values)
+{
+    FrameStats stats;
+    stats.samples = values.size();
+    if (values.empty())
+        return stats;
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&](double p) {
+        size_t rank = (size_t)(p / 100.0 * values.size() + 0.5);
+        rank = std::min(std::max(rank, (size_t)1), values.size());
+        return values[rank - 1];
+    };
+
+    double sum = 0.0;
+    for (double v : values)
+        sum += v;
+
+    stats.min = values.front();
+    stats.max = values.back();
+    stats.mean = sum / values.size();
+    stats.p50 = percentile(50.0);
+    stats.p95 = percentile(95.0);
+    stats.p99 = percentile(99.0);
+    return stats;
+}
+
+class FrameProfiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    void configure(int warmupFrames, const std::string& outputPath)
+    {
+        warmup = warmupFrames;
+        output = outputPath;
+        active = true;
+
+        // Fixa a ordem das séries principais no relatório
+        series.clear();
+        series.push_back(std::make_pair(std::string("frame"), std::vector<double>()));
+        series.push_back(std::make_pair(std::string("cpu"), std::vector<double>()));
+        series.push_back(std::make_pair(std::string("swap"), std::vector<double>()));
+    }
+
+    bool enabled() const { return active; }
+    bool measuring() const { return active && frameIndex >= warmup; }
+    int warmupFrames() const { return warmup; }
+
+    void beginFrame()
+    {
+        if (!active)
+            return;
+        Clock::time_point now = Clock::now();
+        if (inFrame) {
+            if (measuring())
+                addSample("frame", elapsedMs(frameStart, now));
+            frameIndex++;
+        }
+        frameStart = now;
+        inFrame = true;
+    }
+
+    void beginSwap()
+    {
+        if (active)
+            swapStart = Clock::now();
+    }
+
+    void endSwap()
+    {
+        if (!active || !measuring())
+            return;
+        Clock::time_point now = Clock::now();
+        addSample("cpu", elapsedMs(frameStart, swapStart));
+        addSample("swap", elapsedMs(swapStart, now));
+    }
+
+    // Fecha o último frame (o intervalo dele termina aqui)
+    void endRun()
+    {
+        if (active && inFrame) {
+            if (measuring())
+                addSample("frame", elapsedMs(frameStart, Clock::now()));
+            frameIndex++;
+            inFrame = false;
+        }
+    }
+
+    void addSample(const std::string& name, double ms)
+    {
+        for (auto& s : series) {
+            if (s.first == name) {
+                s.second.push_back(ms);
+                return;
+            }
+        }
+        series.push_back(std::make_pair(name, std::vector<double>(1, ms)));
+    }
+
+    // Imprime o resumo e grava o arquivo de saída (se configurado).
+    // `info` são pares chave/valor extras (alvo, resolução, renderer...)
+    void report(const std::vector<std::pair<std::string, std::string>>& info) const
+    {
+        if (!active)
+            return;
+
+        std::cout << "Perfil de frames (" << warmup << " de aquecimento):" << std::endl;
+        for (const auto& s : series) {
+            FrameStats st = computeFrameStats(s.second);
+            char line[256];
+            std::snprintf(line, sizeof(line),
+                          "  %-16s n=%-6zu min %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f ms",
+                          s.first.c_str(), st.samples, st.min, st.p50, st.p95, st.p99, st.max);
+            std::cout << line << std::endl;
+        }
+
+        if (output.empty())
+            return;
+
+        std::ofstream out(output.c_str());
+        if (!out.is_open()) {
+            std::cerr << "Erro ao tentar gravar o arquivo " << output << std::endl;
+            return;
+        }
+
+        bool json = output.size() >= 5 && output.compare(output.size() - 5, 5, ".json") == 0;
+        if (json)
+            writeJSON(out, info);
+        else
+            writeCSV(out, info);
+
+        std::cout << "Perfil gravado em " << output << std::endl;
+    }
+
+private:
+    static double elapsedMs(Clock::time_point a, Clock::time_point b)
+    {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    }
+
+    static std::string escapeJSON(const std::string& s)
+    {
+        std::string r;
+        for (char c : s) {
+            if (c == '"' || c == '\\')
+                r += '\\';
+            if ((unsigned char)c >= 0x20)
+                r += c;
+        }
+        return r;
+    }
+
+    static std::string csvField(const std::string& s)
+    {
+        if (s.find_first_of(",\"\n") == std::string::npos)
+            return s;
+        std::string r = "\"";
+        for (char c : s) {
+            if (c == '"')
+                r += '"';
+            r += c;
+        }
+        return r + "\"";
+    }
+
+    void writeJSON(std::ofstream& out, const std::vector<std::pair<std::string, std::string>>& info) const
+    {
+        out << "{\n";
+        for (const auto& kv : info)
+            out << "  \"" << escapeJSON(kv.first) << "\": \"" << escapeJSON(kv.second) << "\",\n";
+        out << "  \"warmup\": " << warmup << ",\n";
+        out << "  \"series\": {";
+        for (size_t i = 0; i < series.size(); i++) {
+            FrameStats st = computeFrameStats(series[i].second);
+            char line[320];
+            std::snprintf(line, sizeof(line),
+                          "%s\n    \"%s\": {\"samples\": %zu, \"min\": %.6f, \"mean\": %.6f, \"p50\": %.6f, "
+                          "\"p95\": %.6f, \"p99\": %.6f, \"max\": %.6f}",
+                          i ? "," : "", escapeJSON(series[i].first).c_str(), st.samples,
+                          st.min, st.mean, st.p50, st.p95, st.p99, st.max);
+            out << line;
+        }
+        out << "\n  }\n}\n";
+    }
+
+    // Uma linha por série; as colunas de `info` se repetem para facilitar juntar vários arquivos
+    void writeCSV(std::ofstream& out, const std::vector<std::pair<std::string, std::string>>& info) const
+    {
+        for (const auto& kv : info)
+            out << csvField(kv.first) << ",";
+        out << "series,samples,min_ms,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+
+        for (const auto& s : series) {
+            FrameStats st = computeFrameStats(s.second);
+            for (const auto& kv : info)
+                out << csvField(kv.second) << ",";
+            char line[256];
+            std::snprintf(line, sizeof(line), "%s,%zu,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n",
+                          s.first.c_str(), st.samples, st.min, st.mean, st.p50, st.p95, st.p99, st.max);
+            out << line;
+        }
+    }
+
+    bool active = false;
+    int warmup = 0;
+    std::string output;
+
+    int frameIndex = 0;
+    bool inFrame = false;
+    Clock::time_point frameStart;
+    Clock::time_point swapStart;
+
+    std::vector<std::pair<std::string, std::vector<double>>> series;
+};
@@ -0,0 +1,263 @@
+/*
+ *  Funções e constantes do OpenGL posteriores à 4.0. A GLAD deste repositório
+ *  (include/glad/glad.h) foi gerada para a versão 4.0, então o que veio
+ *  depois é carregado aqui, com glfwGetProcAddress, na primeira chamada.
+ *  O código usa os nomes normais (glTexStorage2D...): se a GLAD for gerada de
+ *  novo com uma versão mais nova, as definições dela valem e este arquivo não
+ *  faz nada.
+ *
+ *  O ponteiro devolvido não diz se o driver tem a função: com GLX e EGL
+ *  (janela e --headless no Linux) o Mesa devolve um ponteiro válido para
+ *  qualquer nome gl*, que não faz nada se a versão não tiver a função. Por
+ *  isso quem usa uma função daqui consulta antes a versão do contexto ou a
+ *  extensão equivalente (glextHasTextureStorage()...) e tem um caminho
+ *  alternativo.
+ *  Precisa de um contexto ativo na thread que faz a primeira chamada.
+ */
+
+#pragma once
+
+#include <cstring>
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+// Versão do contexto (lida pela GLAD em gladLoadGLLoader) é major.minor ou mais nova
+inline bool glextVersion(int major, int minor)
+{
+    return GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+}
+
+// OpenGL 4.1: binário do programa já linkado (ProgramCache.h)
+#ifndef GL_VERSION_4_1
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length,
+                                                   GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary,
+                                                GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+inline void glextGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat,
+                                  void* binary)
+{
+    static PFNGLGETPROGRAMBINARYPROC fn = (PFNGLGETPROGRAMBINARYPROC)glfwGetProcAddress("glGetProgramBinary");
+    fn(program, bufSize, length, binaryFormat, binary);
+}
+
+inline void glextProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)
+{
+    static PFNGLPROGRAMBINARYPROC fn = (PFNGLPROGRAMBINARYPROC)glfwGetProcAddress("glProgramBinary");
+    fn(program, binaryFormat, binary, length);
+}
+
+inline void glextProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+    static PFNGLPROGRAMPARAMETERIPROC fn = (PFNGLPROGRAMPARAMETERIPROC)glfwGetProcAddress("glProgramParameteri");
+    fn(program, pname, value);
+}
+#define glGetProgramBinary glextGetProgramBinary
+#define glProgramBinary glextProgramBinary
+#define glProgramParameteri glextProgramParameteri
+#endif
+
+// OpenGL 4.1: uniforms de um programa sem precisar dele em uso (ShaderProgram.h)
+#ifndef GL_VERSION_4_1
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM1FPROC)(GLuint program, GLint location, GLfloat v0);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM1IPROC)(GLuint program, GLint location, GLint v0);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM1UIPROC)(GLuint program, GLint location, GLuint v0);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM2FVPROC)(GLuint program, GLint location, GLsizei count,
+                                                     const GLfloat* value);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM3FVPROC)(GLuint program, GLint location, GLsizei count,
+                                                     const GLfloat* value);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM4FVPROC)(GLuint program, GLint location, GLsizei count,
+                                                     const GLfloat* value);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORMMATRIX3FVPROC)(GLuint program, GLint location, GLsizei count,
+                                                          GLboolean transpose, const GLfloat* value);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORMMATRIX4FVPROC)(GLuint program, GLint location, GLsizei count,
+                                                          GLboolean transpose, const GLfloat* value);
+
+inline void glextProgramUniform1f(GLuint program, GLint location, GLfloat v0)
+{
+    static PFNGLPROGRAMUNIFORM1FPROC fn = (PFNGLPROGRAMUNIFORM1FPROC)glfwGetProcAddress("glProgramUniform1f");
+    fn(program, location, v0);
+}
+
+inline void glextProgramUniform1i(GLuint program, GLint location, GLint v0)
+{
+    static PFNGLPROGRAMUNIFORM1IPROC fn = (PFNGLPROGRAMUNIFORM1IPROC)glfwGetProcAddress("glProgramUniform1i");
+    fn(program, location, v0);
+}
+
+inline void glextProgramUniform1ui(GLuint program, GLint location, GLuint v0)
+{
+    static PFNGLPROGRAMUNIFORM1UIPROC fn = (PFNGLPROGRAMUNIFORM1UIPROC)glfwGetProcAddress("glProgramUniform1ui");
+    fn(program, location, v0);
+}
+
+inline void glextProgramUniform2fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+{
+    static PFNGLPROGRAMUNIFORM2FVPROC fn = (PFNGLPROGRAMUNIFORM2FVPROC)glfwGetProcAddress("glProgramUniform2fv");
+    fn(program, location, count, value);
+}
+
+inline void glextProgramUniform3fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+{
+    static PFNGLPROGRAMUNIFORM3FVPROC fn = (PFNGLPROGRAMUNIFORM3FVPROC)glfwGetProcAddress("glProgramUniform3fv");
+    fn(program, location, count, value);
+}
+
+inline void glextProgramUniform4fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+{
+    static PFNGLPROGRAMUNIFORM4FVPROC fn = (PFNGLPROGRAMUNIFORM4FVPROC)glfwGetProcAddress("glProgramUniform4fv");
+    fn(program, location, count, value);
+}
+
+inline void glextProgramUniformMatrix3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose,
+                                         const GLfloat* value)
+{
+    static PFNGLPROGRAMUNIFORMMATRIX3FVPROC fn =
+        (PFNGLPROGRAMUNIFORMMATRIX3FVPROC)glfwGetProcAddress("glProgramUniformMatrix3fv");
+    fn(program, location, count, transpose, value);
+}
+
+inline void glextProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose,
+                                         const GLfloat* value)
+{
+    static PFNGLPROGRAMUNIFORMMATRIX4FVPROC fn =
+        (PFNGLPROGRAMUNIFORMMATRIX4FVPROC)glfwGetProcAddress("glProgramUniformMatrix4fv");
+    fn(program, location, count, transpose, value);
+}
+#define glProgramUniform1f glextProgramUniform1f
+#define glProgramUniform1i glextProgramUniform1i
+#define glProgramUniform1ui glextProgramUniform1ui
+#define glProgramUniform2fv glextProgramUniform2fv
+#define glProgramUniform3fv glextProgramUniform3fv
+#define glProgramUniform4fv glextProgramUniform4fv
+#define glProgramUniformMatrix3fv glextProgramUniformMatrix3fv
+#define glProgramUniformMatrix4fv glextProgramUniformMatrix4fv
+#endif
+
+// OpenGL 4.2: armazenamento imutável de texturas
+#ifndef GL_VERSION_4_2
+typedef void (APIENTRYP PFNGLTEXSTORAGE2DPROC)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width,
+                                               GLsizei height);
+
+inline void glextTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    static PFNGLTEXSTORAGE2DPROC fn = (PFNGLTEXSTORAGE2DPROC)glfwGetProcAddress("glTexStorage2D");
+    fn(target, levels, internalformat, width, height);
+}
+#define glTexStorage2D glextTexStorage2D
+#endif
+
+// Extensão listada pelo contexto atual (ex.: "GL_EXT_texture_compression_s3tc")
+inline bool glextSupported(const char* extension)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* name = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+        if (name && std::strcmp(name, extension) == 0)
+            return true;
+    }
+    return false;
+}
+
+// glTexStorage2D: OpenGL 4.2 ou GL_ARB_texture_storage
+inline bool glextHasTextureStorage()
+{
+    return glextVersion(4, 2) || glextSupported("GL_ARB_texture_storage");
+}
+
+// glProgramBinary e glGetProgramBinary: OpenGL 4.1 ou GL_ARB_get_program_binary
+inline bool glextHasProgramBinary()
+{
+    return glextVersion(4, 1) || glextSupported("GL_ARB_get_program_binary");
+}
+
+// glProgramUniform*: OpenGL 4.1 ou GL_ARB_separate_shader_objects
+inline bool glextHasProgramUniform()
+{
+    return glextVersion(4, 1) || glextSupported("GL_ARB_separate_shader_objects");
+}
+
+// glGetProgramInterfaceiv e glGetProgramResource*: OpenGL 4.3 ou GL_ARB_program_interface_query
+inline bool glextHasProgramInterfaceQuery()
+{
+    return glextVersion(4, 3) || glextSupported("GL_ARB_program_interface_query");
+}
+
+// Formatos comprimidos em blocos: S3TC (BC1/BC3, extensão) e BPTC (BC7, OpenGL 4.2)
+#ifndef GL_EXT_texture_compression_s3tc
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_EXT_texture_sRGB
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+#ifndef GL_VERSION_4_2
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+
+// OpenGL 4.3: shader storage buffers (o glBindBufferBase da 3.0 já serve para ligar)
+#ifndef GL_VERSION_4_3
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+
+// OpenGL 4.3: consulta de interfaces do programa (uniforms e blocos ativos)
+#ifndef GL_VERSION_4_3
+#define GL_UNIFORM 0x92E1
+#define GL_UNIFORM_BLOCK 0x92E2
+#define GL_SHADER_STORAGE_BLOCK 0x92E6
+#define GL_ACTIVE_RESOURCES 0x92F5
+#define GL_MAX_NAME_LENGTH 0x92F6
+#define GL_NAME_LENGTH 0x92F9
+#define GL_TYPE 0x92FA
+#define GL_ARRAY_SIZE 0x92FB
+#define GL_BLOCK_INDEX 0x92FD
+#define GL_BUFFER_BINDING 0x9302
+#define GL_BUFFER_DATA_SIZE 0x9303
+#define GL_LOCATION 0x930E
+
+typedef void (APIENTRYP PFNGLGETPROGRAMINTERFACEIVPROC)(GLuint program, GLenum programInterface, GLenum pname,
+                                                       GLint* params);
+typedef void (APIENTRYP PFNGLGETPROGRAMRESOURCEIVPROC)(GLuint program, GLenum programInterface, GLuint index,
+                                                      GLsizei propCount, const GLenum* props, GLsizei bufSize,
+                                                      GLsizei* length, GLint* params);
+typedef void (APIENTRYP PFNGLGETPROGRAMRESOURCENAMEPROC)(GLuint program, GLenum programInterface, GLuint index,
+                                                        GLsizei bufSize, GLsizei* length, GLchar* name);
+
+inline void glextGetProgramInterfaceiv(GLuint program, GLenum programInterface, GLenum pname, GLint* params)
+{
+    static PFNGLGETPROGRAMINTERFACEIVPROC fn =
+        (PFNGLGETPROGRAMINTERFACEIVPROC)glfwGetProcAddress("glGetProgramInterfaceiv");
+    fn(program, programInterface, pname, params);
+}
+
+inline void glextGetProgramResourceiv(GLuint program, GLenum programInterface, GLuint index, GLsizei propCount,
+                                      const GLenum* props, GLsizei bufSize, GLsizei* length, GLint* params)
+{
+    static PFNGLGETPROGRAMRESOURCEIVPROC fn =
+        (PFNGLGETPROGRAMRESOURCEIVPROC)glfwGetProcAddress("glGetProgramResourceiv");
+    fn(program, programInterface, index, propCount, props, bufSize, length, params);
+}
+
+inline void glextGetProgramResourceName(GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize,
+                                        GLsizei* length, GLchar* name)
+{
+    static PFNGLGETPROGRAMRESOURCENAMEPROC fn =
+        (PFNGLGETPROGRAMRESOURCENAMEPROC)glfwGetProcAddress("glGetProgramResourceName");
+    fn(program, programInterface, index, bufSize, length, name);
+}
+#define glGetProgramInterfaceiv glextGetProgramInterfaceiv
+#define glGetProgramResourceiv glextGetProgramResourceiv
+#define glGetProgramResourceName glextGetProgramResourceName
+#endif
@@ -0,0 +1,172 @@
+/*
+ *  Medição de tempo de GPU por passada de desenho, com queries GL_TIMESTAMP.
+ *
+ *  Cada passada usa um par de queries (início/fim) por frame, num anel de
+ *  GpuTimer::kFramesInFlight frames: o resultado de um frame só é lido alguns
+ *  frames depois, e apenas se GL_QUERY_RESULT_AVAILABLE já for verdadeiro, então
+ *  a leitura nunca trava o pipeline. Como são timestamps (e não GL_TIME_ELAPSED),
+ *  passadas podem ser aninhadas.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  GpuTimer gpuTimer(&run.profiler);
+ *  ...
+ *  {
+ *      GpuTimer::Scope scope(gpuTimer, "fill");
+ *      glDrawArrays(...);
+ *  }
+ *  gpuTimer.endFrame();          // antes de runSwapBuffers
+ *  ...
+ *  gpuTimer.destroy();           // antes de destruir o contexto
+ *
+ *  Com o FrameProfiler ativo, cada passada gera as séries "gpu:<nome>" e
+ *  "cpu:<nome>" (tempo de CPU gasto submetendo a passada).
+ */
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+#include "FrameProfiler.h"
+
+class GpuTimer
+{
+public:
+    static const int kFramesInFlight = 4;
+
+    explicit GpuTimer(FrameProfiler* profiler = NULL) : profiler(profiler) {}
+
+    void begin(const char* name)
+    {
+        Pass& pass = findPass(name);
+        Slot& slot = pass.slots[frame % kFramesInFlight];
+
+        // O anel deu a volta e o resultado antigo ainda não chegou: descarta
+        // a amostra em vez de esperar por ela
+        if (slot.pending) {
+            slot.pending = false;
+            dropped++;
+        }
+
+        glQueryCounter(slot.queries[0], GL_TIMESTAMP);
+        slot.cpuStart = Clock::now();
+        stack.push_back(&pass);
+    }
+
+    void end()
+    {
+        if (stack.empty())
+            return;
+        Pass& pass = *stack.back();
+        stack.pop_back();
+
+        Slot& slot = pass.slots[frame % kFramesInFlight];
+        glQueryCounter(slot.queries[1], GL_TIMESTAMP);
+        slot.cpuMs = std::chrono::duration<double, std::milli>(Clock::now() - slot.cpuStart).count();
+        slot.pending = true;
+    }
+
+    // Escopo RAII: begin no construtor, end no destrutor
+    class Scope
+    {
+    public:
+        Scope(GpuTimer& timer, const char* name) : timer(timer) { timer.begin(name); }
+        ~Scope() { timer.end(); }
+    private:
+        GpuTimer& timer;
+    };
+
+    // Coleta os resultados que já estão disponíveis e avança o anel
+    void endFrame()
+    {
+        for (Pass& pass : passes) {
+            for (Slot& slot : pass.slots) {
+                if (!slot.pending)
+                    continue;
+
+                GLint available = 0;
+                glGetQueryObjectiv(slot.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                    continue;
+
+                GLuint64 start = 0, stop = 0;
+                glGetQueryObjectui64v(slot.queries[0], GL_QUERY_RESULT, &start);
+                glGetQueryObjectui64v(slot.queries[1], GL_QUERY_RESULT, &stop);
+                slot.pending = false;
+
+                pass.lastGpuMs = (stop - start) / 1.0e6;
+                pass.lastCpuMs = slot.cpuMs;
+                if (profiler && profiler->measuring()) {
+                    profiler->addSample("gpu:" + pass.name, pass.lastGpuMs);
+                    profiler->addSample("cpu:" + pass.name, pass.lastCpuMs);
+                }
+            }
+        }
+        frame++;
+    }
+
+    // Último tempo de GPU conhecido da passada (ms), ou -1 se ainda não há
+    double lastGpuMs(const char* name) const
+    {
+        for (const Pass& pass : passes)
+            if (pass.name == name)
+                return pass.lastGpuMs;
+        return -1.0;
+    }
+
+    int droppedSamples() const { return dropped; }
+
+    void destroy()
+    {
+        for (Pass& pass : passes)
+            for (Slot& slot : pass.slots)
+                glDeleteQueries(2, slot.queries);
+        passes.clear();
+        stack.clear();
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Slot
+    {
+        GLuint queries[2] = {0, 0};
+        bool pending = false;
+        Clock::time_point cpuStart;
+        double cpuMs = 0.0;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        Slot slots[kFramesInFlight];
+        double lastGpuMs = -1.0;
+        double lastCpuMs = -1.0;
+    };
+
+    Pass& findPass(const char* name)
+    {
+        for (Pass& pass : passes)
+            if (pass.name == name)
+                return pass;
+
+        passes.push_back(Pass());
+        Pass& pass = passes.back();
+        pass.name = name;
+        for (Slot& slot : pass.slots)
+            glGenQueries(2, slot.queries);
+        return pass;
+    }
+
+    FrameProfiler* profiler;
+    std::deque<Pass> passes;   // deque: ponteiros em `stack` continuam válidos
+    std::vector<Pass*> stack;
+    unsigned frame = 0;
+    int dropped = 0;
+};
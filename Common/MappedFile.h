@@ -0,0 +1,143 @@
+/*
+ *  Arquivo mapeado em memória (somente leitura), para ler arquivos grandes
+ *  (.obj, caches binários) sem copiar o conteúdo para um buffer próprio.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  MappedFile file;
+ *  if (!file.open("modelo.obj")) { ...erro... }
+ *  const char* begin = file.data();
+ *  const char* end = begin + file.size();
+ *  ...
+ *  (o mapeamento é desfeito no destrutor ou em close())
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile
+{
+public:
+    MappedFile() {}
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path)
+    {
+        close();
+
+#ifdef _WIN32
+        // FILE_SHARE_WRITE: os caches atualizam o cabeçalho com o arquivo mapeado
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            close();
+            return false;
+        }
+        length = (size_t)fileSize.QuadPart;
+
+        // Arquivo vazio: não dá para mapear, mas é um arquivo válido
+        if (length == 0)
+            return true;
+
+        mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mappingHandle) {
+            close();
+            return false;
+        }
+        view = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            close();
+            return false;
+        }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return false;
+        }
+        length = (size_t)st.st_size;
+
+        if (length == 0)
+            return true;
+
+        void* p = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close();
+            return false;
+        }
+        view = (const char*)p;
+        // A leitura é sequencial: deixa o kernel antecipar as páginas
+        madvise(p, length, MADV_SEQUENTIAL);
+#endif
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (view)
+            UnmapViewOfFile(view);
+        if (mappingHandle)
+            CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE)
+            CloseHandle(fileHandle);
+        mappingHandle = NULL;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (view)
+            munmap((void*)view, length);
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+#endif
+        view = NULL;
+        length = 0;
+    }
+
+    bool isOpen() const
+    {
+#ifdef _WIN32
+        return fileHandle != INVALID_HANDLE_VALUE;
+#else
+        return fd >= 0;
+#endif
+    }
+
+    const char* data() const { return view; }
+    size_t size() const { return length; }
+
+private:
+    const char* view = NULL;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = NULL;
+#else
+    int fd = -1;
+#endif
+};
@@ -0,0 +1,507 @@
+/*
+ *  Cache binário de malhas: evita ler o texto do .obj a cada execução.
+ *
+ *  Na primeira carga, loadCachedOBJ lê o .obj (loadIndexedOBJ) e grava ao lado
+ *  dele um arquivo "<modelo>.obj.mesh" com os dados já no formato da GPU:
+ *
+ *    MeshCacheHeader  (versão, formato e layout dos atributos, contagens, caixa
+ *                      envolvente, tamanho/data/hash do .obj de origem)
+ *    vértices         (bloco do VBO, alinhado em 16 bytes)
+ *    índices          (bloco do EBO, 16 ou 32 bits, alinhado em 16 bytes)
+ *    materiais        (mtllib, nomes dos usemtl e submalhas de mesh.groups)
+ *    LODs             (trecho do EBO e erro de cada nível de mesh.lods)
+ *    meshlets         (mesh.meshlets, como estão na memória)
+ *
+ *  Nas cargas seguintes o cache é mapeado em memória (MappedFile.h) e os blocos
+ *  vão direto do mapeamento para glBufferData, sem leitura de texto nem cópia
+ *  intermediária. O cache é descartado (e o .obj lido de novo) se a versão do
+ *  formato, o formato dos vértices ou as opções de carga mudaram, ou se o .obj mudou: tamanho e data
+ *  iguais valem como "não mudou"; se só a data mudou, compara o hash do conteúdo
+ *  e, se for o mesmo, grava a data nova no cabeçalho (não calcula o hash de novo).
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  Mesh mesh;
+ *  loadCachedOBJ("../assets/Modelos3D/Suzanne.obj", mesh);
+ *  ...
+ *  drawMesh(mesh);
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "FileCache.h"
+#include "MappedFile.h"
+#include "ObjLoader.h"
+
+const char kMeshCacheMagic[4] = {'M', 'S', 'H', 'C'};
+const uint32_t kMeshCacheVersion = 5;
+
+// Bits de MeshCacheHeader::flags (opções de carga que mudam o conteúdo)
+const uint32_t kMeshCacheOptimized = 1;
+const uint32_t kMeshCacheTexCoords = 2;
+const uint32_t kMeshCacheNormals = 4;
+const uint32_t kMeshCacheMeshlets = 8;
+const uint32_t kMeshCacheLodShift = 8;      // bits 8..15: ObjLoadOptions::lodLevels (0 = sem LODs)
+
+struct MeshCacheAttribute
+{
+    uint32_t location;
+    uint32_t components;
+    uint32_t type;
+    uint32_t normalized;
+    uint32_t offset;
+};
+
+struct MeshCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t headerSize;            // sizeof(MeshCacheHeader) de quem gravou
+    uint32_t flags;
+
+    uint64_t sourceSize;            // .obj de origem
+    int64_t sourceTime;
+    uint64_t sourceHash;
+
+    uint32_t vertexFormat;          // VertexFormat::key()
+    uint32_t vertexStride;
+    uint32_t attributeCount;
+    MeshCacheAttribute attributes[VertexLayout::kMaxAttributes];
+
+    uint64_t vertexCount;
+    uint64_t vertexOffset;          // bytes desde o início do arquivo
+    uint64_t vertexBytes;
+
+    uint32_t indexType;             // GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT
+    uint32_t reserved;
+    uint64_t indexCount;
+    uint64_t indexOffset;
+    uint64_t indexBytes;
+
+    float boundsMin[3];
+    float boundsMax[3];
+    float quantOffset[3];           // PositionQuantization (posições snorm16)
+    float quantScale[3];
+
+    uint64_t groupOffset;           // MaterialGroups (ver writeMaterialGroups)
+    uint64_t groupBytes;
+    uint64_t lodOffset;             // MeshLod (ver writeMeshLods)
+    uint64_t lodBytes;
+    uint64_t meshletOffset;         // Meshlet[meshletBytes / sizeof(Meshlet)]
+    uint64_t meshletBytes;
+};
+
+// Bloco de materiais: contagens, submalhas e depois as strings (tamanho + bytes)
+struct MeshCacheGroupsHeader
+{
+    uint32_t libraryCount;
+    uint32_t nameCount;
+    uint32_t submeshCount;
+    uint32_t reserved;
+};
+
+struct MeshCacheSubMesh
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t material;
+};
+
+inline void writeMaterialGroups(const MaterialGroups& groups, std::vector<char>& out)
+{
+    MeshCacheGroupsHeader gh = {(uint32_t)groups.libraries.size(), (uint32_t)groups.names.size(),
+                                (uint32_t)groups.submeshes.size(), 0};
+    out.assign((const char*)&gh, (const char*)&gh + sizeof(gh));
+    for (const SubMesh& sub : groups.submeshes) {
+        MeshCacheSubMesh s = {sub.firstIndex, (uint32_t)sub.indexCount, sub.material};
+        out.insert(out.end(), (const char*)&s, (const char*)&s + sizeof(s));
+    }
+    for (int list = 0; list < 2; list++) {
+        for (const std::string& str : list == 0 ? groups.libraries : groups.names) {
+            uint32_t length = (uint32_t)str.size();
+            out.insert(out.end(), (const char*)&length, (const char*)&length + sizeof(length));
+            out.insert(out.end(), str.begin(), str.end());
+        }
+    }
+}
+
+// Falha (sem tocar em `groups`) se o bloco estiver truncado
+inline bool readMaterialGroups(const char* p, size_t size, MaterialGroups& groups)
+{
+    const char* end = p + size;
+    MeshCacheGroupsHeader gh;
+    if (size < sizeof(gh))
+        return false;
+    std::memcpy(&gh, p, sizeof(gh));
+    p += sizeof(gh);
+    if ((size_t)(end - p) / sizeof(MeshCacheSubMesh) < gh.submeshCount)
+        return false;
+
+    MaterialGroups result;
+    for (uint32_t i = 0; i < gh.submeshCount; i++, p += sizeof(MeshCacheSubMesh)) {
+        MeshCacheSubMesh s;
+        std::memcpy(&s, p, sizeof(s));
+        SubMesh sub;
+        sub.firstIndex = s.firstIndex;
+        sub.indexCount = (GLsizei)s.indexCount;
+        sub.material = s.material;
+        result.submeshes.push_back(sub);
+    }
+    for (uint32_t i = 0; i < gh.libraryCount + gh.nameCount; i++) {
+        uint32_t length;
+        if ((size_t)(end - p) < sizeof(length))
+            return false;
+        std::memcpy(&length, p, sizeof(length));
+        p += sizeof(length);
+        if ((size_t)(end - p) < length)
+            return false;
+        (i < gh.libraryCount ? result.libraries : result.names).push_back(std::string(p, length));
+        p += length;
+    }
+    groups = result;
+    return true;
+}
+
+// Bloco de LODs: quantidade (uint32) e, para cada nível, MeshCacheLod seguido
+// de groupCount inícios de trecho (uint32)
+struct MeshCacheLod
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error;
+    uint32_t groupCount;
+};
+
+inline void writeMeshLods(const std::vector<MeshLod>& lods, std::vector<char>& out)
+{
+    uint32_t count = (uint32_t)lods.size();
+    out.assign((const char*)&count, (const char*)&count + sizeof(count));
+    for (const MeshLod& lod : lods) {
+        MeshCacheLod l = {lod.firstIndex, (uint32_t)lod.indexCount, lod.error, (uint32_t)lod.groupStarts.size()};
+        out.insert(out.end(), (const char*)&l, (const char*)&l + sizeof(l));
+        out.insert(out.end(), (const char*)lod.groupStarts.data(),
+                   (const char*)(lod.groupStarts.data() + lod.groupStarts.size()));
+    }
+}
+
+// Falha (sem tocar em `lods`) se o bloco estiver truncado
+inline bool readMeshLods(const char* p, size_t size, std::vector<MeshLod>& lods)
+{
+    const char* end = p + size;
+    uint32_t count;
+    if (size < sizeof(count))
+        return false;
+    std::memcpy(&count, p, sizeof(count));
+    p += sizeof(count);
+
+    std::vector<MeshLod> result;
+    for (uint32_t i = 0; i < count; i++) {
+        MeshCacheLod l;
+        if ((size_t)(end - p) < sizeof(l))
+            return false;
+        std::memcpy(&l, p, sizeof(l));
+        p += sizeof(l);
+        if ((size_t)(end - p) / sizeof(uint32_t) < l.groupCount)
+            return false;
+        MeshLod lod;
+        lod.firstIndex = l.firstIndex;
+        lod.indexCount = (GLsizei)l.indexCount;
+        lod.error = l.error;
+        lod.groupStarts.resize(l.groupCount);
+        std::memcpy(lod.groupStarts.data(), p, l.groupCount * sizeof(uint32_t));
+        p += l.groupCount * sizeof(uint32_t);
+        result.push_back(lod);
+    }
+    lods.swap(result);
+    return true;
+}
+
+inline std::string meshCachePath(const std::string& sourcePath)
+{
+    return sourcePath + ".mesh";
+}
+
+inline uint32_t meshCacheFlags(const ObjLoadOptions& options)
+{
+    return (options.optimize ? kMeshCacheOptimized : 0) | (options.texCoords ? kMeshCacheTexCoords : 0) |
+           (options.normals ? kMeshCacheNormals : 0) | (options.meshlets ? kMeshCacheMeshlets : 0) |
+           ((options.lodLevels > 1 ? (uint32_t)options.lodLevels & 0xFF : 0) << kMeshCacheLodShift);
+}
+
+// Arquivo de cache aberto e validado; os ponteiros apontam para o mapeamento
+class MeshCacheFile
+{
+public:
+    // Falha se o arquivo não existe, está corrompido (tamanhos que não batem
+    // com as contagens, trechos fora do EBO...) ou não corresponde à origem
+    bool open(const std::string& cachePath, const std::string& sourcePath, uint32_t flags,
+              const VertexFormat& format = VertexFormat())
+    {
+        if (!file.open(cachePath) || file.size() < sizeof(MeshCacheHeader))
+            return false;
+
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, kMeshCacheMagic, 4) != 0 || header.version != kMeshCacheVersion ||
+            header.headerSize != sizeof(MeshCacheHeader) || header.flags != flags ||
+            header.vertexFormat != format.key())
+            return false;
+        if (header.attributeCount > (uint32_t)VertexLayout::kMaxAttributes || header.vertexStride == 0)
+            return false;
+        if (header.vertexOffset + header.vertexBytes > file.size() || header.indexOffset + header.indexBytes > file.size() ||
+            header.groupOffset + header.groupBytes > file.size() || header.lodOffset + header.lodBytes > file.size() ||
+            header.meshletOffset + header.meshletBytes > file.size() || header.meshletBytes % sizeof(Meshlet) != 0)
+            return false;
+        if (!readMaterialGroups(file.data() + header.groupOffset, (size_t)header.groupBytes, materialGroups) ||
+            !readMeshLods(file.data() + header.lodOffset, (size_t)header.lodBytes, meshLods))
+            return false;
+        meshletData.resize((size_t)(header.meshletBytes / sizeof(Meshlet)));
+        std::memcpy(meshletData.data(), file.data() + header.meshletOffset, (size_t)header.meshletBytes);
+        if (!validIndexData() || !validVertexData())
+            return false;
+
+        FileCacheSource source;
+        if (!statCacheSource(sourcePath, source) || source.size != header.sourceSize)
+            return false;
+        if (source.time != header.sourceTime) {
+            if (hashCacheSource(sourcePath) != header.sourceHash)
+                return false;
+            header.sourceTime = source.time;
+            updateCacheSourceTime(cachePath, offsetof(MeshCacheHeader, sourceTime), source.time);
+        }
+
+        return true;
+    }
+
+    const MeshCacheHeader& info() const { return header; }
+    const void* vertices() const { return file.data() + header.vertexOffset; }
+    const void* indices() const { return file.data() + header.indexOffset; }
+    const MaterialGroups& groups() const { return materialGroups; }
+    const std::vector<MeshLod>& lods() const { return meshLods; }
+    const std::vector<Meshlet>& meshlets() const { return meshletData; }
+
+    VertexLayout layout() const
+    {
+        VertexLayout layout;
+        layout.stride = (GLsizei)header.vertexStride;
+        for (uint32_t i = 0; i < header.attributeCount; i++) {
+            const MeshCacheAttribute& a = header.attributes[i];
+            layout.add(a.location, (GLint)a.components, a.type, (GLboolean)a.normalized, a.offset);
+        }
+        return layout;
+    }
+
+    void upload(Mesh& mesh, VertexStreams streams = VertexStreams::Interleaved) const
+    {
+        uploadBuffers(mesh, streams);
+        createMeshVertexArrays(mesh);
+    }
+
+    // Só os buffers (pode rodar num contexto compartilhado, ver AssetLoader.h)
+    void uploadBuffers(Mesh& mesh, VertexStreams streams = VertexStreams::Interleaved) const
+    {
+        mesh.lods = meshLods;
+        mesh.meshlets = meshletData;
+        uploadMeshBuffers(vertices(), (size_t)header.vertexBytes, indices(), (size_t)header.indexBytes,
+                          header.indexType, layout(), mesh, streams);
+        mesh.boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+        mesh.boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+        mesh.quantization.offset = glm::vec3(header.quantOffset[0], header.quantOffset[1], header.quantOffset[2]);
+        mesh.quantization.scale = glm::vec3(header.quantScale[0], header.quantScale[1], header.quantScale[2]);
+        mesh.groups = materialGroups;
+    }
+
+private:
+    // Trecho [first, first + count) dentro do EBO
+    bool validRange(uint64_t first, uint64_t count) const
+    {
+        return first <= header.indexCount && count <= header.indexCount - first;
+    }
+
+    // Tipo e tamanho do EBO batem com indexCount, e as submalhas, LODs e
+    // meshlets apontam para dentro dele
+    bool validIndexData() const
+    {
+        uint64_t indexSize = header.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort)
+                           : header.indexType == GL_UNSIGNED_INT  ? sizeof(GLuint)
+                                                                  : 0;
+        if (indexSize == 0 || header.indexBytes != header.indexCount * indexSize)
+            return false;
+        for (const SubMesh& sub : materialGroups.submeshes) {
+            if (!validRange(sub.firstIndex, (uint32_t)sub.indexCount))
+                return false;
+        }
+        for (const MeshLod& lod : meshLods) {
+            if (!validRange(lod.firstIndex, (uint32_t)lod.indexCount))
+                return false;
+            for (GLuint start : lod.groupStarts) {
+                if (start < lod.firstIndex || start > lod.firstIndex + (uint64_t)(uint32_t)lod.indexCount)
+                    return false;
+            }
+        }
+        for (const Meshlet& m : meshletData) {
+            if (!validRange(m.firstIndex, (uint32_t)m.indexCount))
+                return false;
+        }
+        return true;
+    }
+
+    // Vértices inteiros e cada atributo dentro do vértice
+    bool validVertexData() const
+    {
+        if (header.vertexBytes % header.vertexStride != 0 ||
+            header.vertexBytes / header.vertexStride != header.vertexCount)
+            return false;
+        for (uint32_t i = 0; i < header.attributeCount; i++) {
+            const MeshCacheAttribute& a = header.attributes[i];
+            VertexAttribute attribute = {a.location, (GLint)a.components, a.type, (GLboolean)a.normalized, a.offset};
+            if (a.components == 0 || a.components > 4 ||
+                (uint64_t)a.offset + vertexAttributeBytes(attribute) > header.vertexStride)
+                return false;
+        }
+        return true;
+    }
+
+    MappedFile file;
+    MeshCacheHeader header;
+    MaterialGroups materialGroups;
+    std::vector<MeshLod> meshLods;
+    std::vector<Meshlet> meshletData;
+};
+
+// Grava o cache a partir do vBuffer da saída indexada, no formato de
+// vértice de `options`. A escrita é num arquivo temporário renomeado no fim,
+// para que uma gravação interrompida nunca deixe um cache pela metade.
+// Os vértices ficam sempre intercalados (options.streams só vale na carga).
+// Com `lods`, `indices` é o EBO inteiro (todos os níveis, ver parseIndexedOBJ)
+inline bool writeMeshCache(const std::string& cachePath, const std::string& sourcePath,
+                           const std::vector<GLfloat>& vBuffer, const std::vector<GLuint>& indices,
+                           const ObjLoadOptions& options = ObjLoadOptions(), const MaterialGroups* groups = NULL,
+                           const std::vector<MeshLod>* lods = NULL, const std::vector<Meshlet>* meshlets = NULL)
+{
+    FileCacheSource source;
+    if (!statCacheSource(sourcePath, source))
+        return false;
+
+    const size_t strideFloats = objVertexStride(options);
+    std::vector<unsigned char> indexData;
+    GLenum indexType = packIndices(indices, vBuffer.size() / strideFloats, indexData);
+
+    VertexFormat format = objVertexFormat(options);
+    VertexLayout layout = makeVertexLayout(format);
+    std::vector<unsigned char> vertexData;
+    PositionQuantization quant = packObjVertices(vBuffer, options, vertexData);
+    std::vector<char> groupData;
+    writeMaterialGroups(groups ? *groups : MaterialGroups(), groupData);
+    std::vector<char> lodData;
+    writeMeshLods(lods ? *lods : std::vector<MeshLod>(), lodData);
+
+    MeshCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMeshCacheMagic, 4);
+    header.version = kMeshCacheVersion;
+    header.headerSize = sizeof(MeshCacheHeader);
+    header.flags = meshCacheFlags(options);
+    header.sourceSize = source.size;
+    header.sourceTime = source.time;
+    header.sourceHash = hashCacheSource(sourcePath);
+    header.vertexFormat = format.key();
+    header.vertexStride = layout.stride;
+    header.attributeCount = layout.count;
+    for (int i = 0; i < layout.count; i++) {
+        const VertexAttribute& a = layout.attributes[i];
+        header.attributes[i] = {a.location, (uint32_t)a.components, a.type, a.normalized, a.offset};
+    }
+    header.vertexCount = vBuffer.size() / strideFloats;
+    header.vertexOffset = alignFileCache(sizeof(MeshCacheHeader));
+    header.vertexBytes = vertexData.size();
+    header.indexType = indexType;
+    header.indexCount = indices.size();
+    header.indexOffset = alignFileCache(header.vertexOffset + header.vertexBytes);
+    header.indexBytes = indexData.size();
+    header.groupOffset = alignFileCache(header.indexOffset + header.indexBytes);
+    header.groupBytes = groupData.size();
+    header.lodOffset = alignFileCache(header.groupOffset + header.groupBytes);
+    header.lodBytes = lodData.size();
+    header.meshletOffset = alignFileCache(header.lodOffset + header.lodBytes);
+    header.meshletBytes = meshlets ? meshlets->size() * sizeof(Meshlet) : 0;
+
+    glm::vec3 bmin, bmax;
+    computeBounds(vBuffer, strideFloats, bmin, bmax);
+    for (int k = 0; k < 3; k++) {
+        header.boundsMin[k] = bmin[k];
+        header.boundsMax[k] = bmax[k];
+        header.quantOffset[k] = quant.offset[k];
+        header.quantScale[k] = quant.scale[k];
+    }
+
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+
+        const char padding[kFileCacheAlignment] = {};
+        out.write((const char*)&header, sizeof(header));
+        out.write(padding, header.vertexOffset - sizeof(header));
+        out.write((const char*)vertexData.data(), header.vertexBytes);
+        out.write(padding, header.indexOffset - (header.vertexOffset + header.vertexBytes));
+        out.write((const char*)indexData.data(), header.indexBytes);
+        out.write(padding, header.groupOffset - (header.indexOffset + header.indexBytes));
+        out.write(groupData.data(), header.groupBytes);
+        out.write(padding, header.lodOffset - (header.groupOffset + header.groupBytes));
+        out.write(lodData.data(), header.lodBytes);
+        out.write(padding, header.meshletOffset - (header.lodOffset + header.lodBytes));
+        if (meshlets)
+            out.write((const char*)meshlets->data(), header.meshletBytes);
+        if (!out.good()) {
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// loadIndexedOBJ com cache: usa "<filePATH>.mesh" se estiver válido; senão lê
+// o .obj e grava o cache para a próxima execução
+inline bool loadCachedOBJ(std::string filePATH, Mesh& mesh, const ObjLoadOptions& options = ObjLoadOptions())
+{
+    std::string cachePath = meshCachePath(filePATH);
+    uint32_t flags = meshCacheFlags(options);
+
+    {
+        MeshCacheFile cache;
+        if (cache.open(cachePath, filePATH, flags, objVertexFormat(options))) {
+            cache.upload(mesh, options.streams);
+            return true;
+        }
+    }
+
+    std::vector<GLfloat> vBuffer;
+    std::vector<GLuint> indices;
+    if (!parseIndexedOBJ(filePATH, vBuffer, indices, options, &mesh.groups, &mesh.lods, &mesh.meshlets))
+        return false;
+
+    uploadIndexedMesh(vBuffer, indices, mesh, options);
+    if (!writeMeshCache(cachePath, filePATH, vBuffer, indices, options, &mesh.groups, &mesh.lods, &mesh.meshlets))
+        std::cerr << "Aviso: nao foi possivel gravar o cache " << cachePath << std::endl;
+    return true;
+}
@@ -0,0 +1,356 @@
+/*
+ *  Otimização da ordem dos triângulos e dos vértices de malhas indexadas
+ *  (saída do loadIndexedOBJ), para rodar uma vez depois da carga:
+ *
+ *   1. optimizeVertexCache: reordena os triângulos para reaproveitar o cache de
+ *      vértices já transformados da GPU (algoritmo "Tipsify", Sander, Nehab e
+ *      Barczak, 2007). Gera também "clusters": trechos da nova ordem que começam
+ *      com o cache vazio e podem ser trocados de lugar sem piorar o cache;
+ *   2. optimizeOverdraw: ordena esses clusters de fora para dentro (normal do
+ *      cluster apontando para longe do centro da malha primeiro), para que as
+ *      faces da frente tendam a ser desenhadas antes e o teste de profundidade
+ *      descarte mais fragmentos;
+ *   3. optimizeVertexFetch: renumera os vértices na ordem de primeiro uso, para
+ *      que a leitura do VBO seja o mais sequencial possível.
+ *
+ *  analyzeVertexCache simula um cache FIFO e mede:
+ *   - ACMR (average cache miss ratio): vértices transformados por triângulo
+ *     (3.0 = nenhum reaproveitamento; ~0.5 é o limite para malhas regulares);
+ *   - ATVR (average transformed vertex ratio): vértices transformados por
+ *     vértice da malha (1.0 = cada vértice transformado uma vez só).
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  MeshOptimizeStats stats = optimizeMesh(vBuffer, 6, indices);
+ *  printMeshOptimizeStats(stats);
+ *
+ *  (ou ObjLoadOptions::optimize = true no loadIndexedOBJ)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+struct VertexCacheStats
+{
+    double acmr = 0.0;
+    double atvr = 0.0;
+};
+
+struct MeshOptimizeStats
+{
+    VertexCacheStats before;
+    VertexCacheStats after;
+    size_t clusters = 0;
+};
+
+// Tamanho de cache usado nas simulações (ordem de grandeza das GPUs atuais)
+const int kVertexCacheSize = 16;
+
+inline VertexCacheStats analyzeVertexCache(const std::vector<GLuint>& indices, size_t nVertices,
+                                           int cacheSize = kVertexCacheSize)
+{
+    VertexCacheStats stats;
+    if (indices.empty() || nVertices == 0)
+        return stats;
+
+    // FIFO: um vértice está no cache se entrou há menos de `cacheSize` faltas
+    std::vector<size_t> entered(nVertices, 0);
+    std::vector<char> used(nVertices, 0);
+    size_t misses = 0, referenced = 0;
+    for (GLuint v : indices) {
+        if (!used[v]) {
+            used[v] = 1;
+            referenced++;
+        }
+        if (entered[v] == 0 || misses + 1 - entered[v] > (size_t)cacheSize) {
+            misses++;
+            entered[v] = misses;
+        }
+    }
+
+    stats.acmr = (double)misses / (indices.size() / 3);
+    stats.atvr = (double)misses / referenced;
+    return stats;
+}
+
+namespace meshopt
+{
+    // Triângulos que usam cada vértice (listas contíguas, estilo CSR)
+    struct Adjacency
+    {
+        std::vector<GLuint> offsets;
+        std::vector<GLuint> triangles;
+        std::vector<GLuint> live;   // triângulos ainda não emitidos por vértice
+    };
+
+    inline void buildAdjacency(const std::vector<GLuint>& indices, size_t nVertices, Adjacency& adj)
+    {
+        adj.offsets.assign(nVertices + 1, 0);
+        adj.live.assign(nVertices, 0);
+        for (GLuint v : indices)
+            adj.live[v]++;
+        for (size_t v = 0; v < nVertices; v++)
+            adj.offsets[v + 1] = adj.offsets[v] + adj.live[v];
+
+        adj.triangles.resize(indices.size());
+        std::vector<GLuint> fill(adj.offsets.begin(), adj.offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            adj.triangles[fill[indices[i]]++] = (GLuint)(i / 3);
+    }
+}
+
+// Tipsify. `clusters` recebe o primeiro triângulo (na nova ordem) de cada cluster
+inline void optimizeVertexCache(std::vector<GLuint>& indices, size_t nVertices, std::vector<GLuint>* clusters = NULL,
+                                int cacheSize = kVertexCacheSize)
+{
+    size_t nTriangles = indices.size() / 3;
+    if (clusters)
+        clusters->clear();
+    if (nTriangles == 0)
+        return;
+
+    meshopt::Adjacency adj;
+    meshopt::buildAdjacency(indices, nVertices, adj);
+
+    std::vector<GLuint> result;
+    result.reserve(indices.size());
+    std::vector<char> emitted(nTriangles, 0);
+    std::vector<long long> cacheTime(nVertices, 0);
+    std::vector<GLuint> deadEnd;      // vértices recentes, candidatos a recomeço
+    std::vector<GLuint> candidates;
+    long long time = cacheSize + 1;
+    size_t cursor = 0;
+
+    // Próximo vértice com triângulos pendentes: primeiro a pilha de
+    // vértices recentes, senão o próximo na ordem original (novo cluster)
+    auto skipDeadEnd = [&](bool& newCluster) -> long long {
+        while (!deadEnd.empty()) {
+            GLuint d = deadEnd.back();
+            deadEnd.pop_back();
+            if (adj.live[d] > 0)
+                return d;
+        }
+        newCluster = true;
+        for (; cursor < nVertices; cursor++)
+            if (adj.live[cursor] > 0)
+                return (long long)cursor;
+        return -1;
+    };
+
+    bool newCluster = false;
+    long long fan = skipDeadEnd(newCluster);
+    while (fan >= 0) {
+        if (newCluster && clusters)
+            clusters->push_back((GLuint)(result.size() / 3));
+        newCluster = false;
+
+        // Emite todos os triângulos pendentes em volta do vértice atual
+        candidates.clear();
+        for (GLuint k = adj.offsets[fan]; k < adj.offsets[fan + 1]; k++) {
+            GLuint t = adj.triangles[k];
+            if (emitted[t])
+                continue;
+            emitted[t] = 1;
+            for (int c = 0; c < 3; c++) {
+                GLuint v = indices[t * 3 + c];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                adj.live[v]--;
+                if (time - cacheTime[v] > cacheSize)
+                    cacheTime[v] = time++;
+            }
+        }
+
+        // Próximo leque: o vizinho que ainda estará no cache depois de
+        // emitir seus triângulos e que está há mais tempo nele
+        long long next = -1;
+        long long best = -1;
+        for (GLuint v : candidates) {
+            if (adj.live[v] == 0)
+                continue;
+            long long priority = 0;
+            if (time - cacheTime[v] + 2 * (long long)adj.live[v] <= cacheSize)
+                priority = time - cacheTime[v];
+            if (priority > best) {
+                best = priority;
+                next = v;
+            }
+        }
+        fan = next >= 0 ? next : skipDeadEnd(newCluster);
+    }
+
+    indices.swap(result);
+}
+
+// Ordena os clusters do optimizeVertexCache de fora para dentro.
+// `positions` aponta para x, y, z do primeiro vértice; `stride` em floats.
+// Os clusters são antes subdivididos onde o cache, simulado a partir do
+// início do trecho, já tem ACMR até `threshold` vezes o da malha toda: assim
+// há mais trechos para ordenar e o ACMR piora no máximo nessa proporção
+// Retorna quantos clusters foram ordenados
+inline size_t optimizeOverdraw(std::vector<GLuint>& indices, const GLfloat* positions, size_t stride,
+                               const std::vector<GLuint>& hardClusters, float threshold = 1.05f,
+                               int cacheSize = kVertexCacheSize)
+{
+    size_t nTriangles = indices.size() / 3;
+    if (nTriangles == 0 || hardClusters.empty())
+        return 0;
+
+    GLuint maxIndex = *std::max_element(indices.begin(), indices.end());
+    double targetAcmr = threshold * analyzeVertexCache(indices, maxIndex + 1, cacheSize).acmr;
+
+    // Simulação FIFO; "esvaziar" o cache é só avançar o contador de faltas
+    std::vector<size_t> entered(maxIndex + 1, 0);
+    size_t misses = cacheSize + 1;
+    std::vector<GLuint> clusters;
+    for (size_t h = 0; h < hardClusters.size(); h++) {
+        GLuint first = hardClusters[h];
+        GLuint last = h + 1 < hardClusters.size() ? hardClusters[h + 1] : (GLuint)nTriangles;
+
+        clusters.push_back(first);
+        misses += cacheSize + 1;
+        size_t clusterStart = first, clusterMisses = 0;
+        for (GLuint t = first; t < last; t++) {
+            for (int c = 0; c < 3; c++) {
+                GLuint v = indices[t * 3 + c];
+                if (misses - entered[v] >= (size_t)cacheSize) {
+                    entered[v] = ++misses;
+                    clusterMisses++;
+                }
+            }
+            size_t clusterTris = t + 1 - clusterStart;
+            if (t + 1 < last && (double)clusterMisses / clusterTris <= targetAcmr) {
+                clusters.push_back(t + 1);
+                misses += cacheSize + 1;
+                clusterStart = t + 1;
+                clusterMisses = 0;
+            }
+        }
+    }
+    if (clusters.size() <= 1)
+        return clusters.size();
+
+    auto position = [&](GLuint v) {
+        const GLfloat* p = positions + v * stride;
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+
+    // Centro da malha (média dos centróides, ponderada pela área)
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < nTriangles; t++) {
+        glm::vec3 a = position(indices[t * 3]), b = position(indices[t * 3 + 1]), c = position(indices[t * 3 + 2]);
+        float area = glm::length(glm::cross(b - a, c - a));
+        meshCenter += (a + b + c) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea > 0.0f)
+        meshCenter /= meshArea;
+
+    struct Cluster
+    {
+        GLuint first, last;
+        float sortKey;
+    };
+    std::vector<Cluster> sorted(clusters.size());
+    for (size_t i = 0; i < clusters.size(); i++) {
+        Cluster& cl = sorted[i];
+        cl.first = clusters[i];
+        cl.last = i + 1 < clusters.size() ? clusters[i + 1] : (GLuint)nTriangles;
+
+        glm::vec3 center(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (GLuint t = cl.first; t < cl.last; t++) {
+            glm::vec3 a = position(indices[t * 3]), b = position(indices[t * 3 + 1]), c = position(indices[t * 3 + 2]);
+            glm::vec3 n = glm::cross(b - a, c - a);   // comprimento = 2x área
+            float triArea = glm::length(n);
+            center += (a + b + c) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+        if (area > 0.0f)
+            center /= area;
+        float len = glm::length(normal);
+        cl.sortKey = len > 0.0f ? glm::dot(center - meshCenter, normal / len) : 0.0f;
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<GLuint> result;
+    result.reserve(indices.size());
+    for (const Cluster& cl : sorted)
+        result.insert(result.end(), indices.begin() + cl.first * 3, indices.begin() + cl.last * 3);
+    indices.swap(result);
+    return sorted.size();
+}
+
+// Renumera os vértices na ordem de primeiro uso pelos índices e reordena o
+// buffer (`stride` floats por vértice). Vértices sem uso são descartados
+inline void optimizeVertexFetch(std::vector<GLfloat>& vBuffer, size_t stride, std::vector<GLuint>& indices)
+{
+    const GLuint kUnused = 0xFFFFFFFFu;
+    size_t nVertices = vBuffer.size() / stride;
+    std::vector<GLuint> remap(nVertices, kUnused);
+
+    std::vector<GLfloat> result;
+    result.reserve(vBuffer.size());
+    GLuint next = 0;
+    for (GLuint& v : indices) {
+        if (remap[v] == kUnused) {
+            remap[v] = next++;
+            result.insert(result.end(), vBuffer.begin() + v * stride, vBuffer.begin() + (v + 1) * stride);
+        }
+        v = remap[v];
+    }
+    vBuffer.swap(result);
+}
+
+// As três etapas em sequência; as posições são os 3 primeiros floats de cada vértice
+// `groupStarts` (opcional): índices onde começam trechos cujos triângulos não
+// podem se misturar (ex.: submalhas por material). Cada trecho é otimizado
+// separado e continua no mesmo lugar; os vértices são compartilhados
+inline MeshOptimizeStats optimizeMesh(std::vector<GLfloat>& vBuffer, size_t stride, std::vector<GLuint>& indices,
+                                      const std::vector<size_t>* groupStarts = NULL)
+{
+    MeshOptimizeStats stats;
+    size_t nVertices = vBuffer.size() / stride;
+    stats.before = analyzeVertexCache(indices, nVertices);
+
+    std::vector<GLuint> clusters;
+    if (!groupStarts || groupStarts->size() <= 1) {
+        optimizeVertexCache(indices, nVertices, &clusters);
+        stats.clusters = optimizeOverdraw(indices, vBuffer.data(), stride, clusters);
+    } else {
+        std::vector<GLuint> group;
+        for (size_t g = 0; g < groupStarts->size(); g++) {
+            size_t first = (*groupStarts)[g];
+            size_t last = g + 1 < groupStarts->size() ? (*groupStarts)[g + 1] : indices.size();
+            group.assign(indices.begin() + first, indices.begin() + last);
+            optimizeVertexCache(group, nVertices, &clusters);
+            stats.clusters += optimizeOverdraw(group, vBuffer.data(), stride, clusters);
+            std::copy(group.begin(), group.end(), indices.begin() + first);
+        }
+    }
+    optimizeVertexFetch(vBuffer, stride, indices);
+
+    stats.after = analyzeVertexCache(indices, vBuffer.size() / stride);
+    return stats;
+}
+
+inline void printMeshOptimizeStats(const MeshOptimizeStats& stats)
+{
+    std::printf("Cache de vertices (FIFO %d): ACMR %.3f -> %.3f | ATVR %.3f -> %.3f | %zu clusters\n",
+                kVertexCacheSize, stats.before.acmr, stats.after.acmr, stats.before.atvr, stats.after.atvr,
+                stats.clusters);
+}
@@ -0,0 +1,400 @@
+/*
+ *  Simplificação de malhas indexadas por colapso de arestas com métricas de
+ *  erro quádricas (Garland e Heckbert, 1997) e a cadeia de LODs (níveis de
+ *  detalhe) que o loadIndexedOBJ / loadCachedOBJ guardam junto da malha.
+ *
+ *  Cada vértice acumula a quádrica dos planos dos triângulos que o usam (com
+ *  peso = área do triângulo); colapsar a aresta u -> v custa o erro da soma das
+ *  quádricas na posição de v, que é a distância² média aos planos originais.
+ *  A cada passada, as arestas mais baratas são colapsadas, no máximo uma por
+ *  vizinhança, recusando colapsos que invertem triângulos ou criam arestas
+ *  não-manifold.
+ *
+ *  Os vértices nunca são movidos nem criados: cada LOD é só outro trecho de
+ *  índices sobre o mesmo VBO (o EBO guarda todos os níveis, um depois do
+ *  outro). Vértices de borda, de costura (mesma posição com vt/vn diferentes)
+ *  e de fronteira entre materiais ficam fixos, para não abrir buracos nem
+ *  misturar atributos; malhas com muitas costuras simplificam menos.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  std::vector<MeshLod> lods;
+ *  buildMeshLods(vBuffer, 6, indices, 4, lods);   // LOD 0 + 3 níveis, cada um com ~metade dos triângulos
+ *
+ *  (ou ObjLoadOptions::lodLevels = 4 no loadIndexedOBJ / loadCachedOBJ) e, a
+ *  cada frame, o nível pelo tamanho do objeto na tela:
+ *  float ppu = lodPixelsPerUnit(distancia, glm::radians(45.0f), alturaDaJanela);
+ *  drawMeshLod(mesh, selectMeshLod(mesh.lods, ppu));
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "MeshOptimizer.h"
+
+// Um nível de detalhe: trecho do EBO e o erro geométrico em relação ao LOD 0
+struct MeshLod
+{
+    GLuint firstIndex = 0;
+    GLsizei indexCount = 0;
+    float error = 0.0f;                 // desvio estimado da superfície original (unidades do modelo)
+    std::vector<GLuint> groupStarts;    // onde começa cada trecho (submalha) dentro do nível
+};
+
+// Fração dos triângulos mantida de um nível para o seguinte
+const float kMeshLodRatio = 0.5f;
+
+namespace meshsimplify
+{
+    // Quádrica simétrica 4x4 (10 coeficientes) e a soma dos pesos
+    struct Quadric
+    {
+        double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double w = 0;
+
+        // Plano n·p + d = 0 (n unitário)
+        void addPlane(const glm::vec3& n, double d, double weight)
+        {
+            a00 += weight * n.x * n.x; a01 += weight * n.x * n.y; a02 += weight * n.x * n.z;
+            a11 += weight * n.y * n.y; a12 += weight * n.y * n.z; a22 += weight * n.z * n.z;
+            b0 += weight * n.x * d; b1 += weight * n.y * d; b2 += weight * n.z * d;
+            c += weight * d * d;
+            w += weight;
+        }
+
+        Quadric& operator+=(const Quadric& q)
+        {
+            a00 += q.a00; a01 += q.a01; a02 += q.a02; a11 += q.a11; a12 += q.a12; a22 += q.a22;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2; c += q.c;
+            w += q.w;
+            return *this;
+        }
+
+        // Soma ponderada das distâncias² de p aos planos
+        double evaluate(const glm::vec3& p) const
+        {
+            double x = p.x, y = p.y, z = p.z;
+            return a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                   2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        }
+    };
+
+    inline glm::vec3 position(const GLfloat* vertices, size_t stride, GLuint v)
+    {
+        const GLfloat* p = vertices + (size_t)v * stride;
+        return glm::vec3(p[0], p[1], p[2]);
+    }
+
+    // weld[v] = menor índice de vértice com a mesma posição que v
+    inline void weldPositions(const GLfloat* vertices, size_t stride, size_t nVertices, std::vector<GLuint>& weld)
+    {
+        std::vector<GLuint> order(nVertices);
+        std::iota(order.begin(), order.end(), 0);
+        auto less = [&](GLuint a, GLuint b) {
+            int cmp = std::memcmp(vertices + (size_t)a * stride, vertices + (size_t)b * stride, 3 * sizeof(GLfloat));
+            return cmp < 0 || (cmp == 0 && a < b);
+        };
+        std::sort(order.begin(), order.end(), less);
+
+        weld.resize(nVertices);
+        for (size_t i = 0; i < nVertices; i++) {
+            bool same = i > 0 && std::memcmp(vertices + (size_t)order[i] * stride,
+                                             vertices + (size_t)order[i - 1] * stride, 3 * sizeof(GLfloat)) == 0;
+            weld[order[i]] = same ? weld[order[i - 1]] : order[i];
+        }
+    }
+
+    struct Collapse
+    {
+        GLuint from, to;
+        float cost;
+    };
+}
+
+// Simplifica `indices` (triângulos sobre `nVertices` vértices de `stride`
+// floats, posição nos 3 primeiros) até ~targetIndexCount índices, ou até não
+// haver colapso possível. `locked` (opcional) marca vértices que não podem
+// sair do lugar. Retorna o maior erro aceito (distância, unidades do modelo)
+inline float simplifyMesh(const GLfloat* vertices, size_t stride, size_t nVertices, const std::vector<GLuint>& indices,
+                          size_t targetIndexCount, std::vector<GLuint>& out,
+                          const std::vector<unsigned char>* locked = NULL)
+{
+    using namespace meshsimplify;
+
+    out = indices;
+    if (indices.size() <= targetIndexCount || nVertices == 0)
+        return 0.0f;
+
+    // Quádricas por posição (as cópias de uma costura compartilham a mesma)
+    std::vector<GLuint> weld;
+    weldPositions(vertices, stride, nVertices, weld);
+    std::vector<Quadric> quadrics(nVertices);
+    for (size_t i = 0; i + 2 < out.size(); i += 3) {
+        glm::vec3 p0 = position(vertices, stride, out[i]);
+        glm::vec3 n = glm::cross(position(vertices, stride, out[i + 1]) - p0, position(vertices, stride, out[i + 2]) - p0);
+        float doubleArea = glm::length(n);
+        if (doubleArea <= 0.0f)
+            continue;
+        n = n / doubleArea;
+        Quadric q;
+        q.addPlane(n, -glm::dot(n, p0), doubleArea * 0.5);
+        for (int k = 0; k < 3; k++)
+            quadrics[weld[out[i + k]]] += q;
+    }
+
+    // Vértices fixos: pedidos por quem chamou, costuras e os das arestas que
+    // não têm exatamente dois triângulos (borda ou não-manifold)
+    std::vector<unsigned char> fixed(nVertices, 0);
+    if (locked)
+        for (size_t v = 0; v < nVertices && v < locked->size(); v++)
+            fixed[v] = (*locked)[v];
+    for (size_t v = 0; v < nVertices; v++)
+        if (weld[v] != v)
+            fixed[v] = fixed[weld[v]] = 1;
+    {
+        std::vector<unsigned long long> edges;
+        edges.reserve(out.size());
+        for (size_t i = 0; i + 2 < out.size(); i += 3) {
+            for (int k = 0; k < 3; k++) {
+                unsigned long long a = weld[out[i + k]], b = weld[out[i + (k + 1) % 3]];
+                edges.push_back(std::min(a, b) << 32 | std::max(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i;
+            while (j < edges.size() && edges[j] == edges[i])
+                j++;
+            if (j - i != 2)
+                fixed[edges[i] >> 32] = fixed[edges[i] & 0xFFFFFFFFu] = 1;
+            i = j;
+        }
+    }
+    for (size_t v = 0; v < nVertices; v++)
+        fixed[v] = fixed[v] || fixed[weld[v]];
+
+    const size_t targetTriangles = targetIndexCount / 3;
+    double maxCost = 0.0;
+    std::vector<Collapse> candidates;
+    std::vector<unsigned char> touched;
+    std::vector<GLuint> remap(nVertices), ringU, ringV;
+    meshopt::Adjacency adj;
+
+    while (out.size() / 3 > targetTriangles) {
+        size_t nTriangles = out.size() / 3;
+        meshopt::buildAdjacency(out, nVertices, adj);
+
+        // Cada aresta aparece nos seus dois triângulos; só a ordem a < b entra
+        candidates.clear();
+        for (size_t i = 0; i < out.size(); i++) {
+            GLuint a = out[i], b = out[i - i % 3 + (i % 3 + 1) % 3];
+            if (a > b)
+                std::swap(a, b);
+            if (a == b || (fixed[a] && fixed[b]) || out[i] != a)
+                continue;
+            const Quadric& qa = quadrics[weld[a]];
+            const Quadric& qb = quadrics[weld[b]];
+            double w = std::max(qa.w + qb.w, 1e-30);
+            glm::vec3 pa = position(vertices, stride, a), pb = position(vertices, stride, b);
+            if (!fixed[a])
+                candidates.push_back({a, b, (float)std::max((qa.evaluate(pb) + qb.evaluate(pb)) / w, 0.0)});
+            if (!fixed[b])
+                candidates.push_back({b, a, (float)std::max((qa.evaluate(pa) + qb.evaluate(pa)) / w, 0.0)});
+        }
+        if (candidates.empty())
+            break;
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        // Cada colapso interno remove dois triângulos. Só o terço mais barato
+        // das arestas é considerado por passada, para que regiões caras
+        // esperem as mais baratas que surgirem depois
+        size_t needed = (nTriangles - targetTriangles + 1) / 2;
+        size_t considered = std::max<size_t>(1, candidates.size() / 3);
+        touched.assign(nVertices, 0);
+        std::iota(remap.begin(), remap.end(), 0);
+        size_t collapsed = 0;
+
+        for (size_t c = 0; c < considered && collapsed < needed; c++) {
+            GLuint u = candidates[c].from, v = candidates[c].to;
+            if (touched[u] || touched[v])
+                continue;
+
+            // Triângulos em volta de u não podem virar do avesso, e os vizinhos
+            // comuns de u e v têm que ser só os dos triângulos da aresta (link condition)
+            bool ok = true;
+            size_t shared = 0;
+            ringU.clear();
+            ringV.clear();
+            for (GLuint k = adj.offsets[u]; k < adj.offsets[u + 1] && ok; k++) {
+                const GLuint* tri = &out[adj.triangles[k] * 3];
+                for (int j = 0; j < 3; j++)
+                    if (tri[j] != u && tri[j] != v)
+                        ringU.push_back(weld[tri[j]]);
+                if (tri[0] == v || tri[1] == v || tri[2] == v) {
+                    shared++;
+                    continue;
+                }
+                glm::vec3 p[3], q[3];
+                for (int j = 0; j < 3; j++) {
+                    p[j] = position(vertices, stride, tri[j]);
+                    q[j] = position(vertices, stride, tri[j] == u ? v : tri[j]);
+                }
+                glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+                ok = glm::dot(before, after) > 0.0f;
+            }
+            if (!ok)
+                continue;
+            for (GLuint k = adj.offsets[v]; k < adj.offsets[v + 1]; k++) {
+                const GLuint* tri = &out[adj.triangles[k] * 3];
+                for (int j = 0; j < 3; j++)
+                    if (tri[j] != u && tri[j] != v)
+                        ringV.push_back(weld[tri[j]]);
+            }
+            std::sort(ringU.begin(), ringU.end());
+            ringU.erase(std::unique(ringU.begin(), ringU.end()), ringU.end());
+            std::sort(ringV.begin(), ringV.end());
+            ringV.erase(std::unique(ringV.begin(), ringV.end()), ringV.end());
+            size_t common = 0;
+            for (size_t i = 0, j = 0; i < ringU.size() && j < ringV.size();) {
+                if (ringU[i] == ringV[j]) {
+                    common++;
+                    i++;
+                    j++;
+                } else if (ringU[i] < ringV[j]) {
+                    i++;
+                } else {
+                    j++;
+                }
+            }
+            // Numa aresta manifold, os únicos vizinhos comuns são os terceiros
+            // vértices dos triângulos da própria aresta
+            if (shared == 0 || common > shared)
+                continue;
+
+            remap[u] = v;
+            quadrics[weld[v]] += quadrics[weld[u]];
+            maxCost = std::max(maxCost, (double)candidates[c].cost);
+            collapsed++;
+            // A vizinhança de u não muda mais nesta passada
+            for (GLuint k = adj.offsets[u]; k < adj.offsets[u + 1]; k++) {
+                const GLuint* tri = &out[adj.triangles[k] * 3];
+                touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+            }
+        }
+        if (collapsed == 0)
+            break;
+
+        // Aplica os colapsos e descarta os triângulos degenerados
+        size_t kept = 0;
+        for (size_t i = 0; i + 2 < out.size(); i += 3) {
+            GLuint a = remap[out[i]], b = remap[out[i + 1]], c = remap[out[i + 2]];
+            if (a == b || b == c || a == c)
+                continue;
+            out[kept++] = a;
+            out[kept++] = b;
+            out[kept++] = c;
+        }
+        out.resize(kept);
+    }
+
+    return (float)std::sqrt(maxCost);
+}
+
+// Acrescenta a `indices` os níveis 1..levels-1, cada um com ~kMeshLodRatio dos
+// triângulos do anterior (simplificado a partir dele), e preenche `lods`
+// (lods[0] = os índices originais). `groupStarts` (opcional) separa trechos
+// que não podem se misturar (submalhas por material, como no optimizeMesh):
+// cada um é simplificado separado e os vértices entre trechos ficam fixos.
+// Para quando um nível não consegue tirar nem 10% dos triângulos
+inline void buildMeshLods(const std::vector<GLfloat>& vBuffer, size_t stride, std::vector<GLuint>& indices, int levels,
+                          std::vector<MeshLod>& lods, const std::vector<size_t>* groupStarts = NULL,
+                          bool optimize = false)
+{
+    const size_t nVertices = vBuffer.size() / stride;
+    lods.clear();
+
+    MeshLod base;
+    base.indexCount = (GLsizei)indices.size();
+    if (groupStarts && !groupStarts->empty())
+        base.groupStarts.assign(groupStarts->begin(), groupStarts->end());
+    else
+        base.groupStarts.push_back(0);
+    lods.push_back(base);
+    if (levels <= 1 || indices.empty())
+        return;
+
+    std::vector<unsigned char> locked(nVertices, 0);
+    if (base.groupStarts.size() > 1) {
+        std::vector<int> owner(nVertices, -1);
+        for (size_t g = 0; g < base.groupStarts.size(); g++) {
+            size_t last = g + 1 < base.groupStarts.size() ? base.groupStarts[g + 1] : indices.size();
+            for (size_t i = base.groupStarts[g]; i < last; i++) {
+                GLuint v = indices[i];
+                if (owner[v] < 0)
+                    owner[v] = (int)g;
+                else if (owner[v] != (int)g)
+                    locked[v] = 1;
+            }
+        }
+    }
+
+    std::vector<GLuint> group, simplified;
+    for (int level = 1; level < levels; level++) {
+        const MeshLod prev = lods.back();
+        MeshLod lod;
+        lod.firstIndex = (GLuint)indices.size();
+        float error = 0.0f;
+        for (size_t g = 0; g < prev.groupStarts.size(); g++) {
+            size_t first = prev.groupStarts[g];
+            size_t last = g + 1 < prev.groupStarts.size() ? prev.groupStarts[g + 1] : prev.firstIndex + prev.indexCount;
+            group.assign(indices.begin() + first, indices.begin() + last);
+            size_t target = (size_t)(group.size() / 3 * kMeshLodRatio) * 3;
+            error = std::max(error, simplifyMesh(vBuffer.data(), stride, nVertices, group, target, simplified, &locked));
+            if (optimize)
+                optimizeVertexCache(simplified, nVertices);
+            lod.groupStarts.push_back((GLuint)indices.size());
+            indices.insert(indices.end(), simplified.begin(), simplified.end());
+        }
+        lod.indexCount = (GLsizei)(indices.size() - lod.firstIndex);
+        if (lod.indexCount > prev.indexCount * 0.9) {
+            indices.resize(lod.firstIndex);
+            break;
+        }
+        // Cada nível parte do anterior: o erro em relação ao LOD 0 é no máximo a soma
+        lod.error = prev.error + error;
+        lods.push_back(lod);
+    }
+}
+
+// Quantos pixels mede uma unidade do modelo a `distance` da câmera, numa
+// projeção perspectiva com campo de visão vertical `fovY` (radianos) e
+// viewport de `viewportHeight` pixels (multiplicar pela escala do modelo)
+inline float lodPixelsPerUnit(float distance, float fovY, int viewportHeight)
+{
+    return (float)viewportHeight / (2.0f * std::tan(fovY * 0.5f) * std::max(distance, 1e-6f));
+}
+
+// Nível mais simples cujo erro, projetado na tela, fica abaixo de
+// `maxPixelError` pixels: quanto menor o objeto na tela, mais simples o LOD
+inline int selectMeshLod(const std::vector<MeshLod>& lods, float pixelsPerUnit, float maxPixelError = 1.0f)
+{
+    int selected = 0;
+    for (size_t i = 1; i < lods.size(); i++)
+        if (lods[i].error * pixelsPerUnit <= maxPixelError)
+            selected = (int)i;
+    return selected;
+}
@@ -0,0 +1,390 @@
+/*
+ *  Divisão de malhas indexadas em meshlets (grupos pequenos de triângulos
+ *  vizinhos, até kMeshletMaxVertices vértices e kMeshletMaxTriangles
+ *  triângulos) e o descarte (culling) deles na CPU, a cada frame.
+ *
+ *  Cada meshlet guarda uma esfera envolvente e um cone de normais (eixo médio
+ *  e abertura). Um meshlet é descartado se a esfera está fora do frustum ou se
+ *  a câmera está dentro do "cone de costas" (todos os triângulos de costas para
+ *  ela). O teste roda em 4 meshlets por vez (SSE2, com versão escalar para as
+ *  outras arquiteturas) sobre os dados em SoA. Os meshlets que sobram viram
+ *  uma lista de trechos do EBO (trechos vizinhos são juntados) desenhada com um
+ *  glMultiDrawElements, então a GPU só transforma a geometria visível.
+ *
+ *  Os triângulos de cada meshlet ficam contíguos no EBO: buildMeshlets só
+ *  reordena os triângulos (dentro de cada submalha), sem criar vértices.
+ *  Os meshlets cobrem o LOD 0 (ver MeshSimplifier.h).
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  options.meshlets = true;
+ *  loadIndexedOBJ("../assets/Modelos3D/SuzanneSubdiv1.obj", mesh, options);
+ *  MeshletCuller culler;
+ *  culler.setMeshlets(mesh.meshlets);
+ *  ...
+ *  // mvp = projeção * view * model; câmera nas coordenadas do modelo
+ *  culler.cull(mvp, glm::vec3(glm::inverse(model) * glm::vec4(cameraPos, 1.0f)), mesh.indexType, drawList);
+ *  drawMeshlets(mesh, drawList);
+ *
+ *  O teste da esfera supõe que `model` tem escala uniforme.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MESHLET_CULL_SSE2 1
+#endif
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "MeshOptimizer.h"
+
+const size_t kMeshletMaxVertices = 64;
+const size_t kMeshletMaxTriangles = 124;
+
+// Trecho do EBO com os triângulos de um meshlet e os limites para o culling.
+// coneCutoff = 1 quando as normais se espalham demais (nunca descartado por costas)
+struct Meshlet
+{
+    GLuint firstIndex = 0;
+    GLsizei indexCount = 0;
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+    glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    float coneCutoff = 1.0f;
+};
+
+namespace meshlets
+{
+    inline glm::vec3 position(const GLfloat* vertices, size_t stride, GLuint v)
+    {
+        const GLfloat* p = vertices + (size_t)v * stride;
+        return glm::vec3(p[0], p[1], p[2]);
+    }
+
+    // Esfera (centro da caixa envolvente) e cone de normais dos triângulos
+    // tris[0..count) (3 índices cada)
+    inline void computeBounds(const GLfloat* vertices, size_t stride, const GLuint* tris, size_t count,
+                              Meshlet& meshlet)
+    {
+        glm::vec3 bmin = position(vertices, stride, tris[0]), bmax = bmin;
+        for (size_t i = 1; i < count * 3; i++) {
+            glm::vec3 p = position(vertices, stride, tris[i]);
+            bmin = glm::min(bmin, p);
+            bmax = glm::max(bmax, p);
+        }
+        meshlet.center = (bmin + bmax) * 0.5f;
+        float radius2 = 0.0f;
+        for (size_t i = 0; i < count * 3; i++) {
+            glm::vec3 d = position(vertices, stride, tris[i]) - meshlet.center;
+            radius2 = std::max(radius2, glm::dot(d, d));
+        }
+        meshlet.radius = std::sqrt(radius2);
+
+        std::vector<glm::vec3> normals;
+        normals.reserve(count);
+        glm::vec3 sum(0.0f);
+        for (size_t t = 0; t < count; t++) {
+            glm::vec3 p0 = position(vertices, stride, tris[t * 3]);
+            glm::vec3 n = glm::cross(position(vertices, stride, tris[t * 3 + 1]) - p0,
+                                     position(vertices, stride, tris[t * 3 + 2]) - p0);
+            float length = glm::length(n);
+            if (length <= 0.0f)
+                continue;
+            normals.push_back(n / length);
+            sum += normals.back();
+        }
+        meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+        meshlet.coneCutoff = 1.0f;
+        float sumLength = glm::length(sum);
+        if (normals.empty() || sumLength <= 0.0f)
+            return;
+        meshlet.coneAxis = sum / sumLength;
+
+        // Maior ângulo entre uma normal e o eixo; acima de ~84° o cone não descarta nada
+        float minDot = 1.0f;
+        for (const glm::vec3& n : normals)
+            minDot = std::min(minDot, glm::dot(n, meshlet.coneAxis));
+        if (minDot > 0.1f)
+            meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    // Divide os triângulos de `tris` (reordenados no lugar) em meshlets. Cada
+    // meshlet começa no primeiro triângulo pendente e cresce pelos vizinhos
+    // que trazem menos vértices novos (no empate, o mais perto do centro do
+    // meshlet, para ele ficar compacto e a esfera pequena), até um dos limites
+    inline void buildGroup(const GLfloat* vertices, size_t stride, size_t nVertices, std::vector<GLuint>& tris,
+                           GLuint baseIndex, size_t maxVertices, size_t maxTriangles, std::vector<Meshlet>& out)
+    {
+        size_t nTriangles = tris.size() / 3;
+        if (nTriangles == 0)
+            return;
+
+        meshopt::Adjacency adj;
+        meshopt::buildAdjacency(tris, nVertices, adj);
+
+        std::vector<GLuint> result;
+        result.reserve(tris.size());
+        std::vector<char> emitted(nTriangles, 0);
+        std::vector<GLuint> stamp(nVertices, 0);     // meshlet (+1) que já tem o vértice
+        std::vector<GLuint> candidates;
+        GLuint current = 0;
+        size_t cursor = 0;
+
+        while (result.size() < tris.size()) {
+            while (emitted[cursor])
+                cursor++;
+            current++;
+            size_t first = result.size(), vertexCount = 0, triangleCount = 0;
+            glm::vec3 sum(0.0f);
+            candidates.clear();
+            GLuint next = (GLuint)cursor;
+
+            for (;;) {
+                emitted[next] = 1;
+                triangleCount++;
+                for (int k = 0; k < 3; k++) {
+                    GLuint v = tris[next * 3 + k];
+                    result.push_back(v);
+                    if (stamp[v] == current)
+                        continue;
+                    stamp[v] = current;
+                    vertexCount++;
+                    sum += position(vertices, stride, v);
+                    for (GLuint a = adj.offsets[v]; a < adj.offsets[v + 1]; a++)
+                        if (!emitted[adj.triangles[a]])
+                            candidates.push_back(adj.triangles[a]);
+                }
+                if (triangleCount == maxTriangles)
+                    break;
+
+                // Vizinho pendente com menos vértices novos que ainda cabe
+                int bestNew = 4;
+                const size_t kNone = (size_t)-1;
+                size_t best = kNone;
+                float bestDistance = 0.0f;
+                glm::vec3 centroid = sum / (float)vertexCount;
+                for (size_t c = 0; c < candidates.size();) {
+                    GLuint t = candidates[c];
+                    if (emitted[t]) {
+                        candidates[c] = candidates.back();
+                        candidates.pop_back();
+                        continue;
+                    }
+                    int added = (stamp[tris[t * 3]] != current) + (stamp[tris[t * 3 + 1]] != current) +
+                                (stamp[tris[t * 3 + 2]] != current);
+                    if (vertexCount + added <= maxVertices && added <= bestNew) {
+                        glm::vec3 d = position(vertices, stride, tris[t * 3]) + position(vertices, stride, tris[t * 3 + 1]) +
+                                      position(vertices, stride, tris[t * 3 + 2]) - centroid * 3.0f;
+                        float distance = glm::dot(d, d);
+                        if (added < bestNew || distance < bestDistance) {
+                            bestNew = added;
+                            best = c;
+                            bestDistance = distance;
+                        }
+                    }
+                    c++;
+                }
+                if (best == kNone)
+                    break;
+                next = candidates[best];
+            }
+
+            Meshlet meshlet;
+            meshlet.firstIndex = baseIndex + (GLuint)first;
+            meshlet.indexCount = (GLsizei)(triangleCount * 3);
+            computeBounds(vertices, stride, &result[first], triangleCount, meshlet);
+            out.push_back(meshlet);
+        }
+        tris.swap(result);
+    }
+}
+
+// Reordena os triângulos de indices[0..indexCount) em meshlets e preenche
+// `meshlets` (indexCount = 0: todos). `groupStarts` (opcional) separa trechos
+// que não podem se misturar (submalhas por material, como no optimizeMesh);
+// nenhum meshlet atravessa um trecho
+inline void buildMeshlets(const std::vector<GLfloat>& vBuffer, size_t stride, std::vector<GLuint>& indices,
+                          std::vector<Meshlet>& meshlets, const std::vector<size_t>* groupStarts = NULL,
+                          size_t indexCount = 0, size_t maxVertices = kMeshletMaxVertices,
+                          size_t maxTriangles = kMeshletMaxTriangles)
+{
+    meshlets.clear();
+    size_t nVertices = vBuffer.size() / stride;
+    size_t end = indexCount ? std::min(indexCount, indices.size()) : indices.size();
+
+    std::vector<size_t> starts;
+    if (groupStarts && !groupStarts->empty())
+        starts = *groupStarts;
+    else
+        starts.push_back(0);
+
+    std::vector<GLuint> group;
+    for (size_t g = 0; g < starts.size(); g++) {
+        size_t first = starts[g];
+        size_t last = g + 1 < starts.size() ? starts[g + 1] : end;
+        group.assign(indices.begin() + first, indices.begin() + last);
+        meshlets::buildGroup(vBuffer.data(), stride, nVertices, group, (GLuint)first, maxVertices, maxTriangles,
+                             meshlets);
+        std::copy(group.begin(), group.end(), indices.begin() + first);
+    }
+}
+
+// Trechos do EBO que sobreviveram ao culling, prontos para o glMultiDrawElements
+struct MeshletDrawList
+{
+    std::vector<GLsizei> counts;
+    std::vector<const void*> offsets;
+    size_t visible = 0;             // meshlets desenhados
+    size_t frustumCulled = 0;
+    size_t backfaceCulled = 0;
+    size_t triangles = 0;
+};
+
+// Culling dos meshlets de uma malha; os limites ficam em SoA (múltiplo de 4)
+class MeshletCuller
+{
+public:
+    void setMeshlets(const std::vector<Meshlet>& meshlets)
+    {
+        count = meshlets.size();
+        size_t padded = (count + 3) & ~(size_t)3;
+        for (int i = 0; i < 8; i++)
+            bounds[i].assign(padded, 0.0f);
+        ranges.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            const Meshlet& m = meshlets[i];
+            float values[8] = {m.center.x, m.center.y, m.center.z, m.radius,
+                               m.coneAxis.x, m.coneAxis.y, m.coneAxis.z, m.coneCutoff};
+            for (int k = 0; k < 8; k++)
+                bounds[k][i] = values[k];
+            ranges[i] = {m.firstIndex, m.indexCount};
+        }
+        flags.assign(padded, 0);
+    }
+
+    size_t size() const { return count; }
+
+    // `mvp` leva do espaço do modelo ao clip; `cameraPos` é a câmera no espaço do modelo
+    void cull(const glm::mat4& mvp, const glm::vec3& cameraPos, GLenum indexType, MeshletDrawList& list)
+    {
+        list.counts.clear();
+        list.offsets.clear();
+        list.visible = list.frustumCulled = list.backfaceCulled = list.triangles = 0;
+
+        // Planos do frustum (Gribb e Hartmann), normalizados: dentro se n·p + d >= -r
+        glm::vec4 planes[6];
+        for (int i = 0; i < 3; i++) {
+            for (int k = 0; k < 4; k++) {
+                planes[i * 2][k] = mvp[k][3] + mvp[k][i];
+                planes[i * 2 + 1][k] = mvp[k][3] - mvp[k][i];
+            }
+        }
+        for (glm::vec4& p : planes)
+            p /= std::max(glm::length(glm::vec3(p)), 1e-20f);
+
+        testBounds(planes, cameraPos);
+
+        size_t indexBytes = indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+        GLuint end = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (flags[i] == 1) {
+                list.frustumCulled++;
+                continue;
+            }
+            if (flags[i] == 2) {
+                list.backfaceCulled++;
+                continue;
+            }
+            list.visible++;
+            list.triangles += ranges[i].indexCount / 3;
+            // Meshlets vizinhos no EBO viram um trecho só
+            if (!list.counts.empty() && ranges[i].firstIndex == end) {
+                list.counts.back() += ranges[i].indexCount;
+            } else {
+                list.counts.push_back(ranges[i].indexCount);
+                list.offsets.push_back((const void*)(ranges[i].firstIndex * indexBytes));
+            }
+            end = ranges[i].firstIndex + ranges[i].indexCount;
+        }
+    }
+
+private:
+    struct Range
+    {
+        GLuint firstIndex;
+        GLsizei indexCount;
+    };
+
+    // flags[i]: 0 = visível, 1 = fora do frustum, 2 = de costas
+    void testBounds(const glm::vec4 planes[6], const glm::vec3& camera)
+    {
+        const float* cx = bounds[0].data();
+        const float* cy = bounds[1].data();
+        const float* cz = bounds[2].data();
+        const float* r = bounds[3].data();
+        const float* ax = bounds[4].data();
+        const float* ay = bounds[5].data();
+        const float* az = bounds[6].data();
+        const float* cut = bounds[7].data();
+        size_t i = 0;
+
+#ifdef MESHLET_CULL_SSE2
+        for (; i + 4 <= flags.size(); i += 4) {
+            __m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+            __m128 radius = _mm_loadu_ps(r + i);
+            __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+            __m128 outside = _mm_setzero_ps();
+            for (int p = 0; p < 6; p++) {
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(planes[p].x)),
+                                                 _mm_mul_ps(y, _mm_set1_ps(planes[p].y))),
+                                      _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(planes[p].z)), _mm_set1_ps(planes[p].w)));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negRadius));
+            }
+
+            // Costas: dot(c - câmera, eixo) >= cutoff * |c - câmera| + r
+            __m128 vx = _mm_sub_ps(x, _mm_set1_ps(camera.x));
+            __m128 vy = _mm_sub_ps(y, _mm_set1_ps(camera.y));
+            __m128 vz = _mm_sub_ps(z, _mm_set1_ps(camera.z));
+            __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)),
+                                                 _mm_mul_ps(vz, vz)));
+            __m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, _mm_loadu_ps(ax + i)),
+                                                 _mm_mul_ps(vy, _mm_loadu_ps(ay + i))),
+                                      _mm_mul_ps(vz, _mm_loadu_ps(az + i)));
+            __m128 back = _mm_cmpge_ps(along, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(cut + i), dist), radius));
+
+            int outsideMask = _mm_movemask_ps(outside), backMask = _mm_movemask_ps(back);
+            for (int k = 0; k < 4; k++)
+                flags[i + k] = (outsideMask >> k & 1) ? 1 : (backMask >> k & 1) ? 2 : 0;
+        }
+#endif
+        for (; i < flags.size(); i++) {
+            unsigned char flag = 0;
+            for (int p = 0; p < 6 && !flag; p++)
+                if (planes[p].x * cx[i] + planes[p].y * cy[i] + planes[p].z * cz[i] + planes[p].w < -r[i])
+                    flag = 1;
+            if (!flag) {
+                glm::vec3 v = glm::vec3(cx[i], cy[i], cz[i]) - camera;
+                if (glm::dot(v, glm::vec3(ax[i], ay[i], az[i])) >= cut[i] * glm::length(v) + r[i])
+                    flag = 2;
+            }
+            flags[i] = flag;
+        }
+    }
+
+    size_t count = 0;
+    std::vector<float> bounds[8];       // cx, cy, cz, raio, eixo x/y/z, cutoff
+    std::vector<Range> ranges;
+    std::vector<unsigned char> flags;
+};
@@ -0,0 +1,223 @@
+/*
+ *  Leitor de bibliotecas de materiais Wavefront .MTL (as referenciadas pelo
+ *  `mtllib` dos .obj) e desenho de malhas agrupadas por material.
+ *
+ *  O loadIndexedOBJ / loadCachedOBJ já deixa os triângulos de cada material
+ *  contíguos no EBO (mesh.groups, ver ObjLoader.h). loadMeshMaterials lê os
+ *  .mtl e devolve um Material para cada nome de mesh.groups.names, na mesma
+ *  ordem; drawMeshByMaterial liga o VAO uma vez e, para cada material, chama
+ *  `bindMaterial` (uniforms, texturas) e faz um único glDrawElements.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  Mesh mesh;
+ *  loadIndexedOBJ("../assets/Modelos3D/Suzanne.obj", mesh);
+ *  std::vector<Material> materials;
+ *  loadMeshMaterials("../assets/Modelos3D/Suzanne.obj", mesh, materials);
+ *  ...
+ *  drawMeshByMaterial(mesh, materials, [&](const Material& m) {
+ *      glUniform3f(kdLoc, m.diffuse.r, m.diffuse.g, m.diffuse.b);
+ *  });
+ *
+ *  Comandos lidos: newmtl, Ka, Kd, Ks, Ke, Ns, Ni, d, Tr, illum, map_Ka,
+ *  map_Kd, map_Ks, map_d, map_Bump / bump / norm. Nos map_*, as opções
+ *  (-bm 1.0, -s ...) são ignoradas e vale a última palavra da linha; o
+ *  caminho é resolvido em relação à pasta do .mtl.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "MappedFile.h"
+#include "ObjLoader.h"
+
+struct Material
+{
+    std::string name;
+    glm::vec3 ambient = glm::vec3(1.0f);    // Ka
+    glm::vec3 diffuse = glm::vec3(0.8f);    // Kd
+    glm::vec3 specular = glm::vec3(0.0f);   // Ks
+    glm::vec3 emission = glm::vec3(0.0f);   // Ke
+    float shininess = 0.0f;                 // Ns
+    float refraction = 1.0f;                // Ni
+    float opacity = 1.0f;                   // d (ou 1 - Tr)
+    int illum = 2;
+
+    // Texturas (caminhos já relativos à pasta atual; vazio = sem textura)
+    std::string ambientMap;
+    std::string diffuseMap;
+    std::string specularMap;
+    std::string alphaMap;
+    std::string normalMap;
+};
+
+namespace mtlparse
+{
+    inline const char* parseVec3(const char* p, const char* end, glm::vec3& out)
+    {
+        p = objparse::parseFloat(p, end, out.x);
+        // "Kd 0.5" vale para os três canais
+        out.y = out.z = out.x;
+        p = objparse::parseFloat(p, end, out.y);
+        p = objparse::parseFloat(p, end, out.z);
+        return p;
+    }
+
+    // Última palavra da linha (o arquivo, depois das opções do map_*)
+    inline std::string mapPath(const char* p, const char* end, const std::filesystem::path& dir)
+    {
+        std::string file;
+        for (p = objparse::skipBlanks(p, end); p < end; p = objparse::skipBlanks(p, end)) {
+            const char* word = p;
+            p = objparse::skipToken(p, end);
+            file.assign(word, p);
+        }
+        if (file.empty())
+            return file;
+        return (dir / file).lexically_normal().generic_string();
+    }
+}
+
+// Acrescenta em `materials` os materiais do texto de um .mtl em [begin, end)
+inline void parseMTLText(const char* begin, const char* end, const std::filesystem::path& dir,
+                         std::vector<Material>& materials)
+{
+    using namespace objparse;
+
+    Material* current = NULL;
+    const char* p = begin;
+    while (p < end) {
+        const char* lineEnd = (const char*)std::memchr(p, '\n', end - p);
+        if (!lineEnd)
+            lineEnd = end;
+
+        p = skipBlanks(p, lineEnd);
+        const char* wordStart = p;
+        p = skipToken(p, lineEnd);
+        std::string word(wordStart, p);
+
+        if (word == "newmtl") {
+            materials.push_back(Material());
+            current = &materials.back();
+            current->name = restOfLine(p, lineEnd);
+        } else if (current) {
+            if (word == "Ka")
+                mtlparse::parseVec3(p, lineEnd, current->ambient);
+            else if (word == "Kd")
+                mtlparse::parseVec3(p, lineEnd, current->diffuse);
+            else if (word == "Ks")
+                mtlparse::parseVec3(p, lineEnd, current->specular);
+            else if (word == "Ke")
+                mtlparse::parseVec3(p, lineEnd, current->emission);
+            else if (word == "Ns")
+                parseFloat(p, lineEnd, current->shininess);
+            else if (word == "Ni")
+                parseFloat(p, lineEnd, current->refraction);
+            else if (word == "d")
+                parseFloat(p, lineEnd, current->opacity);
+            else if (word == "Tr") {
+                float transparency = 0.0f;
+                parseFloat(p, lineEnd, transparency);
+                current->opacity = 1.0f - transparency;
+            } else if (word == "illum") {
+                float illum = (float)current->illum;
+                parseFloat(p, lineEnd, illum);
+                current->illum = (int)illum;
+            } else if (word == "map_Ka")
+                current->ambientMap = mtlparse::mapPath(p, lineEnd, dir);
+            else if (word == "map_Kd")
+                current->diffuseMap = mtlparse::mapPath(p, lineEnd, dir);
+            else if (word == "map_Ks")
+                current->specularMap = mtlparse::mapPath(p, lineEnd, dir);
+            else if (word == "map_d")
+                current->alphaMap = mtlparse::mapPath(p, lineEnd, dir);
+            else if (word == "map_Bump" || word == "map_bump" || word == "bump" || word == "norm")
+                current->normalMap = mtlparse::mapPath(p, lineEnd, dir);
+        }
+
+        p = lineEnd + 1;
+    }
+}
+
+inline bool loadMTL(const std::string& filePATH, std::vector<Material>& materials)
+{
+    MappedFile file;
+    if (!file.open(filePATH)) {
+        std::cerr << "Erro ao tentar ler o arquivo " << filePATH << std::endl;
+        return false;
+    }
+    parseMTLText(file.data(), file.data() + file.size(), std::filesystem::path(filePATH).parent_path(), materials);
+    return true;
+}
+
+// Lê os mtllib de mesh.groups (relativos à pasta do .obj) e monta `materials`
+// alinhado com mesh.groups.names. Nomes que não estão em nenhum .mtl recebem
+// o material padrão (com aviso). Retorna false se algum .mtl não pôde ser lido
+inline bool loadMeshMaterials(const std::string& objPATH, const Mesh& mesh, std::vector<Material>& materials)
+{
+    std::filesystem::path dir = std::filesystem::path(objPATH).parent_path();
+    std::vector<Material> library;
+    bool ok = true;
+    for (const std::string& lib : mesh.groups.libraries)
+        ok = loadMTL((dir / lib).generic_string(), library) && ok;
+
+    materials.clear();
+    for (const std::string& name : mesh.groups.names) {
+        const Material* found = NULL;
+        for (const Material& m : library)
+            if (m.name == name)
+                found = &m;     // o último definido vale, como nos exportadores
+        if (!found)
+            std::cerr << "Aviso: material " << name << " nao encontrado em " << objPATH << std::endl;
+        materials.push_back(found ? *found : Material());
+        materials.back().name = name;
+    }
+    return ok;
+}
+
+// Um glDrawElements por submalha (uma por material), com o VAO ligado uma
+// vez só. `bindMaterial` recebe o material de cada submalha antes do desenho;
+// triângulos sem usemtl (ou sem material correspondente) usam Material().
+// `lod` escolhe o nível de detalhe (mesh.lods, ver MeshSimplifier.h)
+inline void drawMeshByMaterial(const Mesh& mesh, const std::vector<Material>& materials,
+                               const std::function<void(const Material&)>& bindMaterial, int lod = 0)
+{
+    static const Material kDefault;
+
+    if (mesh.groups.submeshes.empty()) {
+        bindMaterial(kDefault);
+        drawMeshLod(mesh, lod);
+        return;
+    }
+
+    // Os trechos de cada nível seguem a ordem de mesh.groups.submeshes
+    const std::vector<SubMesh>& submeshes = mesh.groups.submeshes;
+    const MeshLod* level = NULL;
+    if (lod > 0 && lod < (int)mesh.lods.size() && mesh.lods[lod].groupStarts.size() == submeshes.size())
+        level = &mesh.lods[lod];
+
+    glBindVertexArray(mesh.VAO);
+    for (size_t g = 0; g < submeshes.size(); g++) {
+        SubMesh sub = submeshes[g];
+        if (level) {
+            GLuint last = g + 1 < submeshes.size() ? level->groupStarts[g + 1] : level->firstIndex + level->indexCount;
+            sub.firstIndex = level->groupStarts[g];
+            sub.indexCount = (GLsizei)(last - sub.firstIndex);
+        }
+        bool known = sub.material >= 0 && sub.material < (int)materials.size();
+        bindMaterial(known ? materials[sub.material] : kDefault);
+        drawSubMesh(mesh, sub);
+    }
+}
@@ -0,0 +1,313 @@
+/*
+ *  Gerador de arquivos .OBJ sintéticos e determinísticos, para testar e medir
+ *  o leitor (ObjLoader.h) com arquivos de qualquer tamanho (de 1 mil a dezenas
+ *  de milhões de triângulos).
+ *
+ *  A malha é uma grade ondulada (altura = ondas + ruído a partir de `seed`):
+ *  as mesmas opções geram sempre o mesmo arquivo, byte a byte. Dá para escolher:
+ *   - quantos triângulos (a grade é dimensionada para chegar o mais perto possível);
+ *   - os atributos: só "v", ou também "vt" e/ou "vn" (faces "v", "v/vt", "v//vn"
+ *     ou "v/vt/vn");
+ *   - o tipo de face: triângulos, quadriláteros ou n-gons (hexágonos e
+ *     quadriláteros alternados), que o leitor triangula em leque;
+ *   - índices relativos (negativos) no lugar dos absolutos.
+ *  O número de triângulos depois de triangular é o mesmo nos três tipos de face.
+ *
+ *  O texto é montado num buffer com std::to_chars e gravado em blocos, então
+ *  gerar arquivos de vários GB leva segundos, não minutos.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  ObjGenOptions options;
+ *  options.triangles = 1000000;
+ *  options.normals = true;
+ *  options.faces = ObjGenFaces::Polygons;
+ *  generateOBJ(objGenFileName(options), options);   // "gen_1000000_vn_ngon.obj"
+ *
+ *  (ou o executável objgen; o objcorpusbench gera um conjunto de arquivos e mede o leitor)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+enum class ObjGenFaces : uint8_t { Triangles, Quads, Polygons };
+
+struct ObjGenOptions
+{
+    long long triangles = 100000;           // depois da triangulação
+    bool texCoords = false;                 // grava "vt" e usa nas faces
+    bool normals = false;                   // grava "vn" e usa nas faces
+    ObjGenFaces faces = ObjGenFaces::Triangles;
+    bool relativeIndices = false;           // índices negativos (relativos ao fim da lista)
+    uint32_t seed = 1;                      // ruído da altura
+};
+
+// O que foi gravado
+struct ObjGenStats
+{
+    long long triangles = 0;
+    long long vertices = 0;
+    long long faces = 0;
+    long long bytes = 0;
+};
+
+// Nome que identifica as opções (ex.: "gen_1000000_vtn_tri.obj")
+inline std::string objGenFileName(const ObjGenOptions& options)
+{
+    static const char* const kFaces[] = {"tri", "quad", "ngon"};
+    std::string attribs = "v";
+    if (options.texCoords)
+        attribs += "t";
+    if (options.normals)
+        attribs += "n";
+    std::string name = "gen_" + std::to_string(options.triangles) + "_" + attribs + "_" + kFaces[(int)options.faces];
+    if (options.relativeIndices)
+        name += "_rel";
+    if (options.seed != 1)
+        name += "_s" + std::to_string(options.seed);
+    return name + ".obj";
+}
+
+namespace objgen
+{
+    // Texto montado em memória e gravado em blocos
+    class Writer
+    {
+    public:
+        explicit Writer(FILE* file) : file(file) { buffer.reserve(kBlock + 256); }
+
+        void put(const char* text)
+        {
+            while (*text)
+                buffer.push_back(*text++);
+        }
+
+        void put(char c) { buffer.push_back(c); }
+
+        void put(long long value)
+        {
+            char tmp[24];
+            char* end = std::to_chars(tmp, tmp + sizeof(tmp), value).ptr;
+            buffer.insert(buffer.end(), tmp, end);
+        }
+
+        void put(float value, int precision)
+        {
+            char tmp[48];
+            char* end = std::to_chars(tmp, tmp + sizeof(tmp), value, std::chars_format::fixed, precision).ptr;
+            buffer.insert(buffer.end(), tmp, end);
+        }
+
+        // Fim de linha; grava o bloco quando enche
+        void endLine()
+        {
+            buffer.push_back('\n');
+            if (buffer.size() >= kBlock)
+                flush();
+        }
+
+        bool flush()
+        {
+            if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+                failed = true;
+            written += (long long)buffer.size();
+            buffer.clear();
+            return !failed;
+        }
+
+        long long bytes() const { return written; }
+
+    private:
+        static const size_t kBlock = 1 << 20;
+        FILE* file;
+        std::vector<char> buffer;
+        long long written = 0;
+        bool failed = false;
+    };
+
+    // Ruído em [-1, 1] a partir da posição na grade e da semente (sem estado)
+    inline float noise(uint32_t i, uint32_t j, uint32_t seed)
+    {
+        uint32_t h = i * 0x8da6b343u ^ j * 0xd8163841u ^ seed * 0xcb1ab31fu;
+        h ^= h >> 16;
+        h *= 0x7feb352du;
+        h ^= h >> 15;
+        h *= 0x846ca68bu;
+        h ^= h >> 16;
+        return (float)(h & 0xFFFFFF) / (float)0x7FFFFF - 1.0f;
+    }
+
+    inline float height(float x, float z, uint32_t i, uint32_t j, uint32_t seed)
+    {
+        return 0.1f * std::sin(x * 6.0f) * std::cos(z * 6.0f) + 0.005f * noise(i, j, seed);
+    }
+}
+
+// Grava o arquivo; falha se não conseguir abrir ou gravar `path`
+inline bool generateOBJ(const std::string& path, const ObjGenOptions& options, ObjGenStats* stats = NULL)
+{
+    using objgen::Writer;
+
+    // Grade de cols x rows células, 2 triângulos por célula. Com n-gons, as
+    // células vão aos pares (hexágono), então cols é par
+    long long cells = std::max(1LL, (options.triangles + 1) / 2);
+    long long cols = std::max(1LL, (long long)std::ceil(std::sqrt((double)cells)));
+    if (options.faces == ObjGenFaces::Polygons && cols % 2)
+        cols++;
+    long long rows = std::max(1LL, (cells + cols - 1) / cols);
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    Writer out(f);
+
+    const long long stride = cols + 1;
+    const long long nVertices = stride * (rows + 1);
+    out.put("# grade ");
+    out.put(cols);
+    out.put('x');
+    out.put(rows);
+    out.put(" gerada pelo objgen (seed ");
+    out.put((long long)options.seed);
+    out.put(")");
+    out.endLine();
+
+    for (long long j = 0; j <= rows; j++) {
+        for (long long i = 0; i <= cols; i++) {
+            float x = (float)i / cols * 2.0f - 1.0f;
+            float z = (float)j / rows * 2.0f - 1.0f;
+            out.put("v ");
+            out.put(x, 6);
+            out.put(' ');
+            out.put(objgen::height(x, z, (uint32_t)i, (uint32_t)j, options.seed), 6);
+            out.put(' ');
+            out.put(z, 6);
+            out.endLine();
+        }
+    }
+    if (options.texCoords) {
+        for (long long j = 0; j <= rows; j++) {
+            for (long long i = 0; i <= cols; i++) {
+                out.put("vt ");
+                out.put((float)i / cols, 6);
+                out.put(' ');
+                out.put((float)j / rows, 6);
+                out.endLine();
+            }
+        }
+    }
+    if (options.normals) {
+        // Normal das ondas (sem o ruído): (-dy/dx, 1, -dy/dz) normalizado
+        for (long long j = 0; j <= rows; j++) {
+            for (long long i = 0; i <= cols; i++) {
+                float x = (float)i / cols * 2.0f - 1.0f;
+                float z = (float)j / rows * 2.0f - 1.0f;
+                float dx = 0.6f * std::cos(x * 6.0f) * std::cos(z * 6.0f);
+                float dz = -0.6f * std::sin(x * 6.0f) * std::sin(z * 6.0f);
+                float inv = 1.0f / std::sqrt(dx * dx + 1.0f + dz * dz);
+                out.put("vn ");
+                out.put(-dx * inv, 4);
+                out.put(' ');
+                out.put(inv, 4);
+                out.put(' ');
+                out.put(-dz * inv, 4);
+                out.endLine();
+            }
+        }
+    }
+
+    // Mesmo índice para v, vt e vn (as listas têm a mesma ordem)
+    auto corner = [&](long long v) {
+        long long index = options.relativeIndices ? v - nVertices : v + 1;
+        out.put(' ');
+        out.put(index);
+        if (options.texCoords || options.normals) {
+            out.put('/');
+            if (options.texCoords)
+                out.put(index);
+            if (options.normals) {
+                out.put('/');
+                out.put(index);
+            }
+        }
+    };
+
+    long long faces = 0;
+    for (long long j = 0; j < rows; j++) {
+        for (long long i = 0; i < cols; i++) {
+            // a b (linha j) / c d (linha j + 1), anti-horário visto de +y
+            long long a = j * stride + i, b = a + 1, c = a + stride, d = c + 1;
+            switch (options.faces) {
+            case ObjGenFaces::Triangles:
+                out.put('f');
+                corner(a);
+                corner(c);
+                corner(b);
+                out.endLine();
+                out.put('f');
+                corner(b);
+                corner(c);
+                corner(d);
+                out.endLine();
+                faces += 2;
+                break;
+            case ObjGenFaces::Quads:
+                out.put('f');
+                corner(a);
+                corner(c);
+                corner(d);
+                corner(b);
+                out.endLine();
+                faces++;
+                break;
+            case ObjGenFaces::Polygons:
+                // Pares de células: um hexágono em linhas pares, dois quadriláteros nas ímpares
+                if (i % 2)
+                    break;
+                if (j % 2 == 0) {
+                    // Começa no ponto do meio (b): o leque a partir de um canto
+                    // teria um triângulo degenerado (a, b, b + 1 alinhados)
+                    out.put('f');
+                    corner(b);
+                    corner(a);
+                    corner(c);
+                    corner(d);
+                    corner(d + 1);
+                    corner(b + 1);
+                    out.endLine();
+                    faces++;
+                } else {
+                    for (long long k = 0; k < 2; k++) {
+                        out.put('f');
+                        corner(a + k);
+                        corner(c + k);
+                        corner(d + k);
+                        corner(b + k);
+                        out.endLine();
+                    }
+                    faces += 2;
+                }
+                break;
+            }
+        }
+    }
+
+    bool ok = out.flush();
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok)
+        std::remove(path.c_str());
+    if (stats) {
+        stats->triangles = rows * cols * 2;
+        stats->vertices = nVertices;
+        stats->faces = faces;
+        stats->bytes = out.bytes();
+    }
+    return ok;
+}
@@ -0,0 +1,1006 @@
+/*
+ *  Leitor de arquivos Wavefront .OBJ (versão rápida do `loadSimpleOBJ` de
+ *  "Code snippets/LoadSimpleOBJ.cpp").
+ *
+ *  O arquivo é mapeado em memória (MappedFile.h) e percorrido com ponteiros:
+ *  os números são lidos com std::from_chars direto do texto, sem criar
+ *  std::string / std::istringstream por linha ou por índice de face.
+ *  O `vBuffer` gerado é o mesmo da versão original (x, y, z, r, g, b por vértice);
+ *  com ObjLoadOptions::texCoords e ::normals, cada vértice leva também os vt
+ *  (location 2) e vn (location 3) do arquivo, como na saída indexada.
+ *
+ *  Forma de uso (igual à original):
+ *  -----------------
+ *  int nVertices;
+ *  GLuint objVAO = loadSimpleOBJ("../assets/Modelos3D/Suzanne.obj", nVertices);
+ *  ...
+ *  glBindVertexArray(objVAO);
+ *  glDrawArrays(GL_TRIANGLES, 0, nVertices);
+ *
+ *  Arquivos grandes são lidos em paralelo (ObjLoadOptions::threads): o texto é
+ *  dividido em blocos que terminam em fim de linha, cada bloco é lido numa
+ *  thread com índices locais e depois os blocos são juntados com somas de
+ *  prefixo (deslocamento de cada bloco nas listas finais), corrigindo os
+ *  índices relativos. O resultado é idêntico ao da leitura com uma thread.
+ *
+ *  Saída indexada (loadIndexedOBJ): cada combinação v/vt/vn distinta vira um
+ *  único vértice e os triângulos passam a ser um buffer de índices (EBO) de
+ *  16 bits (até 65536 vértices) ou 32 bits. Vértices compartilhados entre
+ *  faces são armazenados e processados pelo vertex shader uma vez só:
+ *  -----------------
+ *  Mesh mesh;
+ *  loadIndexedOBJ("../assets/Modelos3D/Suzanne.obj", mesh);
+ *  ...
+ *  drawMesh(mesh);   // glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, 0)
+ *  ...
+ *  destroyMesh(mesh);
+ *
+ *  Por padrão a saída indexada também leva só posição e cor; ObjLoadOptions::texCoords
+ *  e ::normals incluem os vt (location 2) e vn (location 3) do arquivo.
+ *  ObjLoadOptions::streams escolhe atributos intercalados num VBO (AoS) ou
+ *  um VBO por atributo (SoA); nos dois casos mesh.positionVAO lê só a posição,
+ *  para passadas de profundidade (drawMesh(mesh, true)).
+ *
+ *  ObjLoadOptions::format escolhe o formato dos vértices na GPU (por exemplo,
+ *  packedVertexFormat(): posição snorm16 + cor RGBA8, 12 bytes em vez de 24).
+ *  Com posições snorm16, o vertex shader precisa aplicar mesh.quantization.
+ *
+ *  Com ObjLoadOptions::optimize, a ordem dos triângulos e dos vértices é
+ *  otimizada para o cache de vértices, overdraw e leitura do VBO (MeshOptimizer.h).
+ *
+ *  Com ObjLoadOptions::lodLevels > 1, a saída indexada ganha uma cadeia de LODs
+ *  (MeshSimplifier.h): os níveis simplificados vão para o mesmo EBO, depois do
+ *  original, e mesh.lods diz onde está cada um. drawMesh continua desenhando o
+ *  LOD 0; drawMeshLod desenha o nível escolhido por selectMeshLod.
+ *
+ *  Com ObjLoadOptions::meshlets, os triângulos do LOD 0 são agrupados em
+ *  meshlets (Meshlets.h) com esfera e cone de normais em mesh.meshlets; o
+ *  MeshletCuller descarta os invisíveis e drawMeshlets desenha o resto com um
+ *  glMultiDrawElements.
+ *
+ *  Materiais: as linhas mtllib/usemtl são registradas em ObjData, e a saída
+ *  indexada agrupa os triângulos por material (mesh.groups): os de cada
+ *  material ficam contíguos no EBO e viram uma SubMesh (um glDrawElements).
+ *  Os arquivos .mtl são lidos por MtlLoader.h.
+ *
+ *  Diferenças em relação à original:
+ *   - faces com mais de 3 vértices são trianguladas em leque (a original
+ *     copiava os cantos em sequência, o que não forma triângulos válidos);
+ *   - índices negativos (relativos ao fim da lista, permitidos no formato) são aceitos.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "Meshlets.h"
+#include "ThreadPool.h"
+#include "VertexFormat.h"
+
+// Índices (base 0) de posição, coord. de textura e normal de um canto de face.
+// -1 indica atributo ausente (ex.: "f 1//3" não tem textura)
+struct ObjIndex
+{
+    int v, t, n;
+};
+
+// Trecho contíguo do EBO com os triângulos de um material
+struct SubMesh
+{
+    GLuint firstIndex = 0;
+    GLsizei indexCount = 0;
+    int material = -1;      // posição em MaterialGroups::names; -1 = sem usemtl
+};
+
+// Materiais referenciados pelo .obj e as submalhas de cada um
+struct MaterialGroups
+{
+    std::vector<std::string> libraries;     // mtllib (relativos à pasta do .obj)
+    std::vector<std::string> names;         // usemtl, na ordem em que aparecem
+    std::vector<SubMesh> submeshes;         // no máximo uma por material, na ordem do EBO
+};
+
+// Geometria carregada na GPU. Com EBO == 0 a malha não é indexada
+// (glDrawArrays com nVertices); senão, glDrawElements com indexCount/indexType
+struct Mesh
+{
+    GLuint VAO = 0;
+    GLuint VBO = 0;                 // atributos intercalados (AoS)
+    std::vector<GLuint> streamVBOs; // um VBO por atributo (SoA), no lugar do VBO
+    GLuint positionVAO = 0;         // só a posição (passada de profundidade)
+    GLuint EBO = 0;
+    GLsizei nVertices = 0;
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    // Posições snorm16 relativas à caixa envolvente: o shader aplica
+    // offset + scale * posição (ver VertexFormat.h)
+    PositionQuantization quantization;
+    MaterialGroups groups;
+    // Níveis de detalhe no EBO; lods[0] é a malha completa (vazio = sem LODs)
+    std::vector<MeshLod> lods;
+    // Grupos de triângulos do LOD 0 para o culling na CPU (vazio = sem meshlets)
+    std::vector<Meshlet> meshlets;
+    // Como os VBOs foram montados (para criar os VAOs, ver createMeshVertexArrays)
+    VertexLayout layout;
+    VertexStreams streams = VertexStreams::Interleaved;
+};
+
+// A partir do canto `corner`, os triângulos usam o material `material`
+// (posição em ObjData::materialNames)
+struct ObjMaterialRun
+{
+    size_t corner;
+    int material;
+};
+
+// Dados brutos do .obj: atributos e os cantos dos triângulos (3 por triângulo)
+struct ObjData
+{
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<ObjIndex> corners;
+    std::vector<std::string> materialLibs;
+    std::vector<std::string> materialNames;
+    std::vector<ObjMaterialRun> materialRuns;
+};
+
+struct ObjLoadOptions
+{
+    int threads = 0;                        // 0 = todos os núcleos, 1 = sem threads
+    size_t minChunkBytes = 4 * 1024 * 1024; // blocos menores que isso não compensam uma thread
+    bool optimize = false;                  // saída indexada: reordena para o cache de vértices (MeshOptimizer.h)
+    VertexFormat format;                    // saída indexada: formato dos vértices na GPU (VertexFormat.h)
+    bool texCoords = false;                 // inclui os vt (location 2)
+    bool normals = false;                   // inclui os vn (location 3)
+    VertexStreams streams = VertexStreams::Interleaved;
+    int lodLevels = 1;                      // saída indexada: níveis de detalhe, com o original (MeshSimplifier.h)
+    bool meshlets = false;                  // saída indexada: agrupa o LOD 0 em meshlets para o culling (Meshlets.h)
+};
+
+// vBuffer (indexado ou não): x, y, z, r, g, b [, u, v] [, nx, ny, nz]
+inline size_t objVertexStride(const ObjLoadOptions& options)
+{
+    return 6 + (options.texCoords ? 2 : 0) + (options.normals ? 3 : 0);
+}
+
+// Layout do vBuffer do loadSimpleOBJ: x, y, z (location 0), r, g, b (location 1)
+// e, se pedidos, u, v (location 2) e nx, ny, nz (location 3), tudo em float
+inline VertexLayout objVertexLayout(const ObjLoadOptions& options = ObjLoadOptions())
+{
+    VertexFormat format = floatVertexFormat();
+    if (options.texCoords)
+        format.texCoord = TexCoordFormat::Float2;
+    if (options.normals)
+        format.normal = NormalFormat::Float3;
+    return makeVertexLayout(format);
+}
+
+inline FloatVertexSource objVertexSource(const std::vector<GLfloat>& vBuffer, const ObjLoadOptions& options)
+{
+    FloatVertexSource source;
+    source.data = vBuffer.data();
+    source.stride = objVertexStride(options);
+    source.count = vBuffer.size() / source.stride;
+    source.texCoord = options.texCoords ? 6 : -1;
+    source.normal = options.normals ? (options.texCoords ? 8 : 6) : -1;
+    return source;
+}
+
+// options.format com os atributos pedidos (float se o formato não disser outro)
+inline VertexFormat objVertexFormat(const ObjLoadOptions& options)
+{
+    VertexFormat format = options.format;
+    if (!options.texCoords)
+        format.texCoord = TexCoordFormat::None;
+    else if (format.texCoord == TexCoordFormat::None)
+        format.texCoord = TexCoordFormat::Float2;
+    if (!options.normals)
+        format.normal = NormalFormat::None;
+    else if (format.normal == NormalFormat::None)
+        format.normal = NormalFormat::Float3;
+    return format;
+}
+
+// Canto de face com índice negativo (relativo). Numa leitura em blocos ele foi
+// resolvido com a contagem local do bloco e precisa somar o deslocamento do bloco
+struct ObjRelativeRef
+{
+    size_t corner;
+    unsigned char mask;  // 1 = v, 2 = t, 4 = n
+};
+
+namespace objparse
+{
+    inline bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    inline const char* skipBlanks(const char* p, const char* end)
+    {
+        while (p < end && isBlank(*p))
+            p++;
+        return p;
+    }
+
+    inline const char* skipToken(const char* p, const char* end)
+    {
+        while (p < end && !isBlank(*p))
+            p++;
+        return p;
+    }
+
+    // Lê um float; se não houver número válido, mantém `out` e não avança
+    // (mesmo efeito do `ssline >> valor` da versão original)
+    inline const char* parseFloat(const char* p, const char* end, float& out)
+    {
+        p = skipBlanks(p, end);
+        const char* start = p;
+        if (p < end && *p == '+')
+            p++;
+        std::from_chars_result r = std::from_chars(p, end, out);
+        return r.ec == std::errc() ? r.ptr : start;
+    }
+
+    inline const char* parseInt(const char* p, const char* end, int& out)
+    {
+        if (p < end && *p == '+')
+            p++;
+        std::from_chars_result r = std::from_chars(p, end, out);
+        return r.ptr;
+    }
+
+    // Resto da linha sem os espaços das pontas (nomes de material/arquivo)
+    inline std::string restOfLine(const char* p, const char* end)
+    {
+        p = skipBlanks(p, end);
+        while (end > p && isBlank(end[-1]))
+            end--;
+        return std::string(p, end);
+    }
+
+    inline int findOrAdd(std::vector<std::string>& names, const std::string& name)
+    {
+        for (size_t i = 0; i < names.size(); i++)
+            if (names[i] == name)
+                return (int)i;
+        names.push_back(name);
+        return (int)names.size() - 1;
+    }
+
+    inline void useMaterial(ObjData& data, const std::string& name)
+    {
+        int material = findOrAdd(data.materialNames, name);
+        if (!data.materialRuns.empty() && data.materialRuns.back().corner == data.corners.size())
+            data.materialRuns.back().material = material;
+        else
+            data.materialRuns.push_back({data.corners.size(), material});
+    }
+
+    // Converte o índice do arquivo (base 1, ou negativo = relativo ao fim) para base 0
+    inline int resolveIndex(int index, size_t count)
+    {
+        return index < 0 ? (int)count + index : index - 1;
+    }
+
+    // Lê um canto de face "v", "v/vt", "v//vn" ou "v/vt/vn".
+    // `relativeMask` recebe quais componentes usaram índice negativo
+    inline const char* parseCorner(const char* p, const char* end, const ObjData& data, ObjIndex& c,
+                                   unsigned char& relativeMask)
+    {
+        int vi = 0, ti = 0, ni = 0;
+        bool hasV = false, hasT = false, hasN = false;
+
+        if (p < end && *p != '/') {
+            const char* q = parseInt(p, end, vi);
+            hasV = q != p;
+            p = q;
+        }
+        if (p < end && *p == '/') {
+            p++;
+            if (p < end && *p != '/' && !isBlank(*p)) {
+                const char* q = parseInt(p, end, ti);
+                hasT = q != p;
+                p = q;
+            }
+            if (p < end && *p == '/') {
+                p++;
+                const char* q = parseInt(p, end, ni);
+                hasN = q != p;
+                p = q;
+            }
+        }
+
+        c.v = hasV ? resolveIndex(vi, data.vertices.size()) : 0;
+        c.t = hasT ? resolveIndex(ti, data.texCoords.size()) : -1;
+        c.n = hasN ? resolveIndex(ni, data.normals.size()) : -1;
+        relativeMask = (hasV && vi < 0 ? 1 : 0) | (hasT && ti < 0 ? 2 : 0) | (hasN && ni < 0 ? 4 : 0);
+        return skipToken(p, end);
+    }
+}
+
+// Percorre o texto de um .obj em [begin, end) acumulando em `data`.
+// Se `relative` não for nulo, registra os cantos que usaram índices negativos
+inline void parseOBJText(const char* begin, const char* end, ObjData& data,
+                         std::vector<ObjRelativeRef>* relative = NULL)
+{
+    using namespace objparse;
+
+    std::vector<ObjIndex> face;
+    std::vector<unsigned char> faceMasks;
+    const char* p = begin;
+
+    while (p < end) {
+        const char* lineEnd = (const char*)std::memchr(p, '\n', end - p);
+        if (!lineEnd)
+            lineEnd = end;
+
+        p = skipBlanks(p, lineEnd);
+        const char* word = p;
+        p = skipToken(p, lineEnd);
+        size_t wordLen = p - word;
+
+        if (wordLen == 1 && word[0] == 'v') {
+            glm::vec3 vertice(0.0f);
+            p = parseFloat(p, lineEnd, vertice.x);
+            p = parseFloat(p, lineEnd, vertice.y);
+            p = parseFloat(p, lineEnd, vertice.z);
+            data.vertices.push_back(vertice);
+        } else if (wordLen == 2 && word[0] == 'v' && word[1] == 't') {
+            glm::vec2 vt(0.0f);
+            p = parseFloat(p, lineEnd, vt.s);
+            p = parseFloat(p, lineEnd, vt.t);
+            data.texCoords.push_back(vt);
+        } else if (wordLen == 2 && word[0] == 'v' && word[1] == 'n') {
+            glm::vec3 normal(0.0f);
+            p = parseFloat(p, lineEnd, normal.x);
+            p = parseFloat(p, lineEnd, normal.y);
+            p = parseFloat(p, lineEnd, normal.z);
+            data.normals.push_back(normal);
+        } else if (wordLen == 1 && word[0] == 'f') {
+            // `face` é reaproveitado entre linhas: nenhuma alocação por face
+            face.clear();
+            faceMasks.clear();
+            bool anyRelative = false;
+            for (p = skipBlanks(p, lineEnd); p < lineEnd; p = skipBlanks(p, lineEnd)) {
+                ObjIndex c;
+                unsigned char mask;
+                p = parseCorner(p, lineEnd, data, c, mask);
+                face.push_back(c);
+                faceMasks.push_back(mask);
+                anyRelative = anyRelative || mask;
+            }
+            // Triangulação em leque (triângulos passam direto)
+            for (size_t i = 2; i < face.size(); i++) {
+                size_t tri[3] = {0, i - 1, i};
+                for (size_t k : tri) {
+                    if (relative && anyRelative && faceMasks[k]) {
+                        ObjRelativeRef ref = {data.corners.size(), faceMasks[k]};
+                        relative->push_back(ref);
+                    }
+                    data.corners.push_back(face[k]);
+                }
+            }
+        } else if (wordLen == 6 && std::memcmp(word, "usemtl", 6) == 0) {
+            useMaterial(data, restOfLine(p, lineEnd));
+        } else if (wordLen == 6 && std::memcmp(word, "mtllib", 6) == 0) {
+            // Pode listar mais de um arquivo
+            for (p = skipBlanks(p, lineEnd); p < lineEnd; p = skipBlanks(p, lineEnd)) {
+                const char* name = p;
+                p = skipToken(p, lineEnd);
+                findOrAdd(data.materialLibs, std::string(name, p));
+            }
+        }
+
+        p = lineEnd + 1;
+    }
+}
+
+// Leitura em blocos paralelos (ver comentário no topo do arquivo)
+inline void parseOBJTextParallel(const char* begin, const char* end, ObjData& data, const ObjLoadOptions& options)
+{
+    size_t size = end - begin;
+    int threads = resolveThreadCount(options.threads);
+    size_t maxChunks = std::max<size_t>(1, size / std::max<size_t>(options.minChunkBytes, 1));
+    // Alguns blocos a mais que threads equilibram blocos com conteúdo desigual (v no início, f no fim)
+    size_t nChunks = std::min<size_t>((size_t)threads * 4, maxChunks);
+
+    if (threads <= 1 || nChunks <= 1) {
+        parseOBJText(begin, end, data);
+        return;
+    }
+
+    // Limites dos blocos: cada corte avança até depois do próximo '\n'
+    std::vector<const char*> bounds(nChunks + 1);
+    bounds[0] = begin;
+    bounds[nChunks] = end;
+    for (size_t i = 1; i < nChunks; i++) {
+        const char* cut = std::max(begin + size * i / nChunks, bounds[i - 1]);
+        const char* nl = (const char*)std::memchr(cut, '\n', end - cut);
+        bounds[i] = nl ? nl + 1 : end;
+    }
+
+    std::vector<ObjData> chunks(nChunks);
+    std::vector<std::vector<ObjRelativeRef>> relative(nChunks);
+    parallelFor((int)nChunks, threads, [&](int i) {
+        parseOBJText(bounds[i], bounds[i + 1], chunks[i], &relative[i]);
+    });
+
+    // Somas de prefixo: onde os dados de cada bloco começam nas listas finais
+    std::vector<size_t> vBase(nChunks + 1, 0), tBase(nChunks + 1, 0), nBase(nChunks + 1, 0), cBase(nChunks + 1, 0);
+    for (size_t i = 0; i < nChunks; i++) {
+        vBase[i + 1] = vBase[i] + chunks[i].vertices.size();
+        tBase[i + 1] = tBase[i] + chunks[i].texCoords.size();
+        nBase[i + 1] = nBase[i] + chunks[i].normals.size();
+        cBase[i + 1] = cBase[i] + chunks[i].corners.size();
+    }
+
+    size_t v0 = data.vertices.size(), t0 = data.texCoords.size(), n0 = data.normals.size(), c0 = data.corners.size();
+    data.vertices.resize(v0 + vBase[nChunks]);
+    data.texCoords.resize(t0 + tBase[nChunks]);
+    data.normals.resize(n0 + nBase[nChunks]);
+    data.corners.resize(c0 + cBase[nChunks]);
+
+    parallelFor((int)nChunks, threads, [&](int i) {
+        ObjData& chunk = chunks[i];
+        std::copy(chunk.vertices.begin(), chunk.vertices.end(), data.vertices.begin() + v0 + vBase[i]);
+        std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), data.texCoords.begin() + t0 + tBase[i]);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), data.normals.begin() + n0 + nBase[i]);
+
+        // Índices positivos já são globais; os negativos foram resolvidos com a
+        // contagem local do bloco e recebem o deslocamento do bloco
+        ObjIndex* out = data.corners.data() + c0 + cBase[i];
+        std::copy(chunk.corners.begin(), chunk.corners.end(), out);
+        for (const ObjRelativeRef& ref : relative[i]) {
+            ObjIndex& c = out[ref.corner];
+            if (ref.mask & 1) c.v += (int)(v0 + vBase[i]);
+            if (ref.mask & 2) c.t += (int)(t0 + tBase[i]);
+            if (ref.mask & 4) c.n += (int)(n0 + nBase[i]);
+        }
+
+        // Libera o bloco assim que ele foi copiado (os materiais ficam para o fim)
+        chunk.vertices = std::vector<glm::vec3>();
+        chunk.texCoords = std::vector<glm::vec2>();
+        chunk.normals = std::vector<glm::vec3>();
+        chunk.corners = std::vector<ObjIndex>();
+    });
+
+    // Materiais: os números locais de cada bloco passam para a lista final.
+    // Um bloco que começa sem usemtl continua com o material do anterior
+    for (size_t i = 0; i < nChunks; i++) {
+        for (const std::string& lib : chunks[i].materialLibs)
+            objparse::findOrAdd(data.materialLibs, lib);
+        for (const ObjMaterialRun& run : chunks[i].materialRuns) {
+            int material = objparse::findOrAdd(data.materialNames, chunks[i].materialNames[run.material]);
+            data.materialRuns.push_back({c0 + cBase[i] + run.corner, material});
+        }
+    }
+}
+
+inline bool parseOBJData(const std::string& filePATH, ObjData& data, const ObjLoadOptions& options = ObjLoadOptions())
+{
+    MappedFile file;
+    if (!file.open(filePATH)) {
+        std::cerr << "Erro ao tentar ler o arquivo " << filePATH << std::endl;
+        return false;
+    }
+
+    parseOBJTextParallel(file.data(), file.data() + file.size(), data, options);
+    return true;
+}
+
+// Monta o buffer intercalado x, y, z, r, g, b [, u, v] [, nx, ny, nz] (um
+// vértice por canto de triângulo; vt e vn só se options pedir)
+inline void buildVertexBuffer(const ObjData& data, std::vector<GLfloat>& vBuffer, int threads = 1,
+                              const ObjLoadOptions& options = ObjLoadOptions())
+{
+    glm::vec3 color = glm::vec3(1.0, 0.0, 0.0);
+    const glm::vec3 zero(0.0f);
+    const size_t stride = objVertexStride(options);
+
+    vBuffer.resize(data.corners.size() * stride);
+
+    // Cada tarefa preenche uma faixa contígua do buffer
+    const size_t kBlock = 1 << 18;
+    size_t nBlocks = (data.corners.size() + kBlock - 1) / kBlock;
+    parallelFor((int)nBlocks, threads, [&](int b) {
+        size_t first = b * kBlock;
+        size_t last = std::min(first + kBlock, data.corners.size());
+        GLfloat* out = vBuffer.data() + first * stride;
+        for (size_t i = first; i < last; i++) {
+            const ObjIndex& c = data.corners[i];
+            const glm::vec3& v = (c.v >= 0 && c.v < (int)data.vertices.size()) ? data.vertices[c.v] : zero;
+            *out++ = v.x;
+            *out++ = v.y;
+            *out++ = v.z;
+            *out++ = color.r;
+            *out++ = color.g;
+            *out++ = color.b;
+            if (options.texCoords) {
+                glm::vec2 vt = (c.t >= 0 && c.t < (int)data.texCoords.size()) ? data.texCoords[c.t] : glm::vec2(0.0f);
+                *out++ = vt.s;
+                *out++ = vt.t;
+            }
+            if (options.normals) {
+                const glm::vec3& vn = (c.n >= 0 && c.n < (int)data.normals.size()) ? data.normals[c.n] : zero;
+                *out++ = vn.x;
+                *out++ = vn.y;
+                *out++ = vn.z;
+            }
+        }
+    });
+}
+
+// Tabela hash (endereçamento aberto) de ObjIndex -> número do vértice único
+class ObjVertexMap
+{
+public:
+    explicit ObjVertexMap(size_t expected)
+    {
+        size_t capacity = 64;
+        while (capacity < expected * 2)
+            capacity *= 2;
+        slots.assign(capacity, Slot());
+    }
+
+    // Devolve o número do vértice para `c`; se ele é novo, recebe `next`
+    GLuint insert(const ObjIndex& c, GLuint next, bool& inserted)
+    {
+        if ((used + 1) * 2 > slots.size())
+            grow();
+
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash(c) & mask;; i = (i + 1) & mask) {
+            Slot& s = slots[i];
+            if (s.id == kEmpty) {
+                s.key = c;
+                s.id = next;
+                used++;
+                inserted = true;
+                return next;
+            }
+            if (s.key.v == c.v && s.key.t == c.t && s.key.n == c.n) {
+                inserted = false;
+                return s.id;
+            }
+        }
+    }
+
+private:
+    static const GLuint kEmpty = 0xFFFFFFFFu;
+
+    struct Slot
+    {
+        ObjIndex key = {0, 0, 0};
+        GLuint id = kEmpty;
+    };
+
+    static size_t hash(const ObjIndex& c)
+    {
+        unsigned long long h = (unsigned)c.v * 0x9E3779B97F4A7C15ull;
+        h ^= (unsigned)c.t * 0xC2B2AE3D27D4EB4Full + (h >> 29);
+        h ^= (unsigned)c.n * 0x165667B19E3779F9ull + (h >> 32);
+        return (size_t)(h ^ (h >> 31));
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, Slot());
+        size_t mask = slots.size() - 1;
+        for (const Slot& s : old) {
+            if (s.id == kEmpty)
+                continue;
+            size_t i = hash(s.key) & mask;
+            while (slots[i].id != kEmpty)
+                i = (i + 1) & mask;
+            slots[i] = s;
+        }
+    }
+
+    std::vector<Slot> slots;
+    size_t used = 0;
+};
+
+// Versão indexada do buildVertexBuffer: um vértice (x, y, z, r, g, b e, se
+// pedidos, u, v e nx, ny, nz) por combinação v/vt/vn distinta, na ordem em
+// que aparece, e 3 índices por triângulo
+inline void buildIndexedBuffer(const ObjData& data, std::vector<GLfloat>& vBuffer, std::vector<GLuint>& indices,
+                               const ObjLoadOptions& options = ObjLoadOptions())
+{
+    glm::vec3 color = glm::vec3(1.0, 0.0, 0.0);
+    const glm::vec3 zero(0.0f);
+
+    ObjVertexMap map(std::max(data.vertices.size(), std::min<size_t>(data.corners.size(), 1024)));
+    vBuffer.clear();
+    vBuffer.reserve(data.vertices.size() * objVertexStride(options));
+    indices.resize(data.corners.size());
+
+    GLuint nUnique = 0;
+    for (size_t i = 0; i < data.corners.size(); i++) {
+        const ObjIndex& c = data.corners[i];
+        bool inserted;
+        indices[i] = map.insert(c, nUnique, inserted);
+        if (!inserted)
+            continue;
+
+        nUnique++;
+        const glm::vec3& v = (c.v >= 0 && c.v < (int)data.vertices.size()) ? data.vertices[c.v] : zero;
+        vBuffer.insert(vBuffer.end(), {v.x, v.y, v.z, color.r, color.g, color.b});
+        if (options.texCoords) {
+            glm::vec2 vt = (c.t >= 0 && c.t < (int)data.texCoords.size()) ? data.texCoords[c.t] : glm::vec2(0.0f);
+            vBuffer.insert(vBuffer.end(), {vt.s, vt.t});
+        }
+        if (options.normals) {
+            const glm::vec3& vn = (c.n >= 0 && c.n < (int)data.normals.size()) ? data.normals[c.n] : zero;
+            vBuffer.insert(vBuffer.end(), {vn.x, vn.y, vn.z});
+        }
+    }
+}
+
+// Reordena os triângulos de `indices` (um índice por canto de data.corners,
+// como sai do buildIndexedBuffer) para que os de cada material fiquem
+// contíguos, mantendo a ordem relativa. Triângulos sem usemtl vêm primeiro
+inline void groupTrianglesByMaterial(const ObjData& data, std::vector<GLuint>& indices, MaterialGroups& groups)
+{
+    groups.libraries = data.materialLibs;
+    groups.names = data.materialNames;
+    groups.submeshes.clear();
+
+    size_t nTriangles = indices.size() / 3;
+    if (nTriangles == 0)
+        return;
+
+    // Material de cada triângulo (+1: posição 0 = sem material)
+    std::vector<int> key(nTriangles, 0);
+    std::vector<size_t> count(groups.names.size() + 1, 0);
+    size_t run = 0;
+    int current = 0;
+    for (size_t t = 0; t < nTriangles; t++) {
+        while (run < data.materialRuns.size() && data.materialRuns[run].corner <= t * 3)
+            current = data.materialRuns[run++].material + 1;
+        key[t] = current;
+        count[current]++;
+    }
+
+    // Ordenação por contagem (estável)
+    std::vector<size_t> start(count.size(), 0);
+    for (size_t m = 1; m < count.size(); m++)
+        start[m] = start[m - 1] + count[m - 1];
+    for (size_t m = 0; m < count.size(); m++) {
+        if (count[m] == 0)
+            continue;
+        SubMesh sub;
+        sub.firstIndex = (GLuint)(start[m] * 3);
+        sub.indexCount = (GLsizei)(count[m] * 3);
+        sub.material = (int)m - 1;
+        groups.submeshes.push_back(sub);
+    }
+    if (groups.submeshes.size() == 1)
+        return;     // um material só: a ordem não muda
+
+    std::vector<GLuint> sorted(indices.size());
+    for (size_t t = 0; t < nTriangles; t++) {
+        size_t dst = start[key[t]]++ * 3;
+        sorted[dst] = indices[t * 3];
+        sorted[dst + 1] = indices[t * 3 + 1];
+        sorted[dst + 2] = indices[t * 3 + 2];
+    }
+    indices.swap(sorted);
+}
+
+// Só a parte de CPU do loadIndexedOBJ: lê o arquivo e gera vértices únicos + índices.
+// Com `groups`, agrupa os triângulos por material (sem, a ordem é a do arquivo).
+// Com `lods` e options.lodLevels > 1, acrescenta os níveis simplificados a `indices`.
+// Com `meshlets` e options.meshlets, reordena o LOD 0 em meshlets
+inline bool parseIndexedOBJ(const std::string& filePATH, std::vector<GLfloat>& vBuffer, std::vector<GLuint>& indices,
+                            const ObjLoadOptions& options = ObjLoadOptions(), MaterialGroups* groups = NULL,
+                            std::vector<MeshLod>* lods = NULL, std::vector<Meshlet>* meshlets = NULL)
+{
+    ObjData data;
+    if (!parseOBJData(filePATH, data, options))
+        return false;
+
+    buildIndexedBuffer(data, vBuffer, indices, options);
+    std::vector<size_t> groupStarts;
+    if (groups) {
+        groupTrianglesByMaterial(data, indices, *groups);
+        for (const SubMesh& sub : groups->submeshes)
+            groupStarts.push_back(sub.firstIndex);
+    }
+    if (options.optimize) {
+        // Cada material é otimizado separado, para continuar contíguo
+        std::cout << filePATH << ": ";
+        printMeshOptimizeStats(optimizeMesh(vBuffer, objVertexStride(options), indices, &groupStarts));
+    }
+    // Antes dos LODs: eles partem da ordem final do LOD 0
+    if (meshlets) {
+        meshlets->clear();
+        if (options.meshlets)
+            buildMeshlets(vBuffer, objVertexStride(options), indices, *meshlets, &groupStarts);
+    }
+    if (lods) {
+        lods->clear();
+        if (options.lodLevels > 1)
+            buildMeshLods(vBuffer, objVertexStride(options), indices, options.lodLevels, *lods, &groupStarts,
+                          options.optimize);
+    }
+    return true;
+}
+
+// Só a parte de CPU do loadSimpleOBJ: lê o arquivo e gera o vBuffer
+inline bool parseSimpleOBJ(const std::string& filePATH, std::vector<GLfloat>& vBuffer,
+                           const ObjLoadOptions& options = ObjLoadOptions())
+{
+    ObjData data;
+    if (!parseOBJData(filePATH, data, options))
+        return false;
+
+    buildVertexBuffer(data, vBuffer, options.threads, options);
+    return true;
+}
+
+inline int loadSimpleOBJ(std::string filePATH, int &nVertices, const ObjLoadOptions& options = ObjLoadOptions())
+{
+    std::vector<GLfloat> vBuffer;
+    if (!parseSimpleOBJ(filePATH, vBuffer, options))
+        return -1;
+
+    GLuint VBO, VAO;
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vBuffer.size() * sizeof(GLfloat), vBuffer.data(), GL_STATIC_DRAW);
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    // x, y, z e r, g, b; com options.texCoords/normals, também u, v e nx, ny, nz
+    applyVertexLayout(objVertexLayout(options));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    nVertices = vBuffer.size() / objVertexStride(options);  // valores armazenados por vértice
+
+    return VAO;
+}
+
+
+// Caixa envolvente das posições (3 primeiros floats de cada vértice)
+inline void computeBounds(const std::vector<GLfloat>& vBuffer, size_t strideFloats, glm::vec3& bmin, glm::vec3& bmax)
+{
+    bmin = glm::vec3(0.0f);
+    bmax = glm::vec3(0.0f);
+    for (size_t i = 0; i + 2 < vBuffer.size(); i += strideFloats) {
+        glm::vec3 p(vBuffer[i], vBuffer[i + 1], vBuffer[i + 2]);
+        bmin = i == 0 ? p : glm::min(bmin, p);
+        bmax = i == 0 ? p : glm::max(bmax, p);
+    }
+}
+
+// Índices no formato que vai para o EBO: 16 bits quando todos os vértices
+// cabem, senão 32 bits. Retorna GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT
+inline GLenum packIndices(const std::vector<GLuint>& indices, size_t nVertices, std::vector<unsigned char>& out)
+{
+    if (nVertices <= 65536) {
+        out.resize(indices.size() * sizeof(GLushort));
+        GLushort* p = (GLushort*)out.data();
+        for (size_t i = 0; i < indices.size(); i++)
+            p[i] = (GLushort)indices[i];
+        return GL_UNSIGNED_SHORT;
+    }
+    out.resize(indices.size() * sizeof(GLuint));
+    std::memcpy(out.data(), indices.data(), out.size());
+    return GL_UNSIGNED_INT;
+}
+
+// Cria os VBOs e o EBO direto de blocos de memória já no formato da GPU
+// (o cache binário passa a memória mapeada do arquivo). Se mesh.lods já foi
+// preenchido, o EBO recebe todos os níveis e mesh.indexCount fica com o LOD 0.
+// `vertices` é sempre
+// intercalado; com VertexStreams::Separate cada atributo vai para o seu VBO.
+// Buffers são compartilhados entre contextos: esta parte pode rodar na
+// thread de carga (AssetLoader.h)
+inline void uploadMeshBuffers(const void* vertices, size_t vertexBytes, const void* indexData, size_t indexBytes,
+                              GLenum indexType, const VertexLayout& layout, Mesh& mesh,
+                              VertexStreams streams = VertexStreams::Interleaved)
+{
+    GLsizei indexCount = (GLsizei)(indexBytes / (indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)));
+    mesh.nVertices = (GLsizei)(vertexBytes / layout.stride);
+    mesh.indexCount = mesh.lods.empty() ? indexCount : mesh.lods[0].indexCount;
+    mesh.indexType = indexType;
+    mesh.layout = layout;
+    mesh.streams = streams;
+
+    glGenBuffers(1, &mesh.EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indexData, GL_STATIC_DRAW);
+
+    if (streams == VertexStreams::Interleaved) {
+        glGenBuffers(1, &mesh.VBO);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertexBytes, vertices, GL_STATIC_DRAW);
+    } else {
+        mesh.streamVBOs.resize(layout.count);
+        glGenBuffers(layout.count, mesh.streamVBOs.data());
+        std::vector<unsigned char> stream;
+        for (int i = 0; i < layout.count; i++) {
+            const VertexAttribute& a = layout.attributes[i];
+            GLuint bytes = vertexAttributeBytes(a);
+            stream.resize((size_t)mesh.nVertices * bytes);
+            const unsigned char* src = (const unsigned char*)vertices + a.offset;
+            for (GLsizei v = 0; v < mesh.nVertices; v++)
+                std::memcpy(&stream[(size_t)v * bytes], src + (size_t)v * layout.stride, bytes);
+
+            glBindBuffer(GL_ARRAY_BUFFER, mesh.streamVBOs[i]);
+            glBufferData(GL_ARRAY_BUFFER, stream.size(), stream.data(), GL_STATIC_DRAW);
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+// VAO completo e VAO só com a posição, a partir dos buffers já criados.
+// VAOs não são compartilhados entre contextos: criar no contexto que desenha
+inline void createMeshVertexArrays(Mesh& mesh)
+{
+    const VertexLayout& layout = mesh.layout;
+    bool interleaved = mesh.streams == VertexStreams::Interleaved;
+
+    GLuint* vaos[2] = {&mesh.VAO, &mesh.positionVAO};
+    for (int pass = 0; pass < 2; pass++) {
+        glGenVertexArrays(1, vaos[pass]);
+        glBindVertexArray(*vaos[pass]);
+        // O EBO fica registrado em cada VAO
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+        for (int i = 0; i < layout.count; i++) {
+            const VertexAttribute& a = layout.attributes[i];
+            if (pass == 1 && a.location != kPositionLocation)
+                continue;
+            glBindBuffer(GL_ARRAY_BUFFER, interleaved ? mesh.VBO : mesh.streamVBOs[i]);
+            glVertexAttribPointer(a.location, a.components, a.type, a.normalized,
+                                  interleaved ? layout.stride : (GLsizei)vertexAttributeBytes(a),
+                                  (GLvoid*)(size_t)(interleaved ? a.offset : 0));
+            glEnableVertexAttribArray(a.location);
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+// Cria VBOs/EBO e VAOs de uma vez (ver uploadMeshBuffers)
+inline void uploadMeshData(const void* vertices, size_t vertexBytes, const void* indexData, size_t indexBytes,
+                           GLenum indexType, const VertexLayout& layout, Mesh& mesh,
+                           VertexStreams streams = VertexStreams::Interleaved)
+{
+    uploadMeshBuffers(vertices, vertexBytes, indexData, indexBytes, indexType, layout, mesh, streams);
+    createMeshVertexArrays(mesh);
+}
+
+// Converte o vBuffer da saída indexada para o formato de vértice pedido
+inline PositionQuantization packObjVertices(const std::vector<GLfloat>& vBuffer, const ObjLoadOptions& options,
+                                            std::vector<unsigned char>& out)
+{
+    return packVertices(objVertexFormat(options), objVertexSource(vBuffer, options), out);
+}
+
+// Cria VBOs/EBO a partir do vBuffer da saída indexada e dos índices dos
+// triângulos, sem os VAOs (ver uploadMeshBuffers)
+inline void uploadIndexedMeshBuffers(const std::vector<GLfloat>& vBuffer, const std::vector<GLuint>& indices,
+                                     Mesh& mesh, const ObjLoadOptions& options = ObjLoadOptions())
+{
+    size_t stride = objVertexStride(options);
+    std::vector<unsigned char> indexData;
+    GLenum indexType = packIndices(indices, vBuffer.size() / stride, indexData);
+
+    VertexFormat format = objVertexFormat(options);
+    bool allFloat = format.position == PositionFormat::Float3 && format.color == ColorFormat::Float3 &&
+                    format.texCoord != TexCoordFormat::Half2 && format.normal != NormalFormat::Oct16;
+    if (allFloat) {
+        // O vBuffer já está no formato da GPU
+        uploadMeshBuffers(vBuffer.data(), vBuffer.size() * sizeof(GLfloat), indexData.data(), indexData.size(),
+                          indexType, makeVertexLayout(format), mesh, options.streams);
+    } else {
+        std::vector<unsigned char> vertexData;
+        mesh.quantization = packObjVertices(vBuffer, options, vertexData);
+        uploadMeshBuffers(vertexData.data(), vertexData.size(), indexData.data(), indexData.size(), indexType,
+                          makeVertexLayout(format), mesh, options.streams);
+    }
+    computeBounds(vBuffer, stride, mesh.boundsMin, mesh.boundsMax);
+}
+
+// Cria VAO/VBO/EBO a partir do vBuffer da saída indexada e dos índices dos triângulos
+inline void uploadIndexedMesh(const std::vector<GLfloat>& vBuffer, const std::vector<GLuint>& indices, Mesh& mesh,
+                              const ObjLoadOptions& options = ObjLoadOptions())
+{
+    uploadIndexedMeshBuffers(vBuffer, indices, mesh, options);
+    createMeshVertexArrays(mesh);
+}
+
+inline bool loadIndexedOBJ(std::string filePATH, Mesh& mesh, const ObjLoadOptions& options = ObjLoadOptions())
+{
+    std::vector<GLfloat> vBuffer;
+    std::vector<GLuint> indices;
+    if (!parseIndexedOBJ(filePATH, vBuffer, indices, options, &mesh.groups, &mesh.lods, &mesh.meshlets))
+        return false;
+
+    uploadIndexedMesh(vBuffer, indices, mesh, options);
+    return true;
+}
+
+// Com positionOnly, usa o VAO que só lê a posição (passada de profundidade)
+inline void drawMesh(const Mesh& mesh, bool positionOnly = false)
+{
+    glBindVertexArray(positionOnly && mesh.positionVAO ? mesh.positionVAO : mesh.VAO);
+    if (mesh.EBO)
+        glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, 0);
+    else
+        glDrawArrays(GL_TRIANGLES, 0, mesh.nVertices);
+}
+
+// Desenha só uma submalha; o VAO da malha já precisa estar ligado
+inline void drawSubMesh(const Mesh& mesh, const SubMesh& sub)
+{
+    size_t indexBytes = mesh.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    glDrawElements(GL_TRIANGLES, sub.indexCount, mesh.indexType, (GLvoid*)(sub.firstIndex * indexBytes));
+}
+
+// Desenha o nível de detalhe `lod` (ver selectMeshLod); sem LODs, a malha inteira
+inline void drawMeshLod(const Mesh& mesh, int lod, bool positionOnly = false)
+{
+    if (mesh.lods.empty() || !mesh.EBO) {
+        drawMesh(mesh, positionOnly);
+        return;
+    }
+    const MeshLod& level = mesh.lods[std::min(std::max(lod, 0), (int)mesh.lods.size() - 1)];
+    SubMesh range;
+    range.firstIndex = level.firstIndex;
+    range.indexCount = level.indexCount;
+    glBindVertexArray(positionOnly && mesh.positionVAO ? mesh.positionVAO : mesh.VAO);
+    drawSubMesh(mesh, range);
+}
+
+// Desenha os trechos que sobraram do culling dos meshlets (MeshletCuller::cull)
+inline void drawMeshlets(const Mesh& mesh, const MeshletDrawList& list, bool positionOnly = false)
+{
+    if (list.counts.empty())
+        return;
+    glBindVertexArray(positionOnly && mesh.positionVAO ? mesh.positionVAO : mesh.VAO);
+    glMultiDrawElements(GL_TRIANGLES, list.counts.data(), mesh.indexType, list.offsets.data(),
+                        (GLsizei)list.counts.size());
+}
+
+inline void destroyMesh(Mesh& mesh)
+{
+    glDeleteVertexArrays(1, &mesh.VAO);
+    if (mesh.positionVAO)
+        glDeleteVertexArrays(1, &mesh.positionVAO);
+    if (mesh.VBO)
+        glDeleteBuffers(1, &mesh.VBO);
+    if (!mesh.streamVBOs.empty())
+        glDeleteBuffers((GLsizei)mesh.streamVBOs.size(), mesh.streamVBOs.data());
+    if (mesh.EBO)
+        glDeleteBuffers(1, &mesh.EBO);
+    mesh = Mesh();
+}
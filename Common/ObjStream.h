@@ -0,0 +1,200 @@
+/*
+ *  Carga progressiva de .obj muito grandes (varreduras de vários GB).
+ *
+ *  O loadSimpleOBJ só devolve o VAO depois de montar o vBuffer inteiro
+ *  (72 bytes por triângulo) e enviá-lo num glBufferData. Aqui o arquivo
+ *  mapeado é lido em lotes de `batchBytes` de texto: cada lote vira triângulos
+ *  (mesmo formato x, y, z, r, g, b do loadSimpleOBJ), vai com glBufferSubData
+ *  para o fim de um VBO já alocado com o tamanho final, e o lote é descartado.
+ *  A malha pode ser desenhada a cada passo: mesh.nVertices cresce conforme os
+ *  lotes chegam.
+ *
+ *  Memória na CPU: as posições (v) precisam ficar até o fim, porque qualquer
+ *  face pode usar qualquer vértice anterior; vt/vn não entram no vBuffer e são
+ *  descartados a cada lote. Fora as posições, o pico é o de um lote (texto
+ *  mapeado + triângulos do lote), e não o do arquivo inteiro.
+ *
+ *  O tamanho do VBO vem de uma passada rápida que só conta os cantos das
+ *  linhas "f" (faces com n cantos viram n - 2 triângulos).
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  ObjStream stream;
+ *  stream.open("scan.obj");
+ *  while (runShouldContinue(window, run)) {
+ *      stream.step();                 // um lote por frame
+ *      drawMesh(stream.mesh());       // o que já chegou
+ *      ...
+ *  }
+ *  stream.close();                    // libera o arquivo; a malha continua
+ *  destroyMesh(stream.mesh());
+ *
+ *  Limitação: índices negativos de vt/vn não são resolvidos (não são usados
+ *  no vBuffer); os de posição funcionam normalmente.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "MappedFile.h"
+#include "ObjLoader.h"
+
+class ObjStream
+{
+public:
+    static const size_t kDefaultBatchBytes = 16 * 1024 * 1024;
+
+    // Mapeia o arquivo, conta os triângulos e cria o VAO/VBO vazio
+    bool open(const std::string& filePATH, size_t batchBytes = kDefaultBatchBytes)
+    {
+        close();
+        if (!file.open(filePATH)) {
+            std::cerr << "Erro ao tentar ler o arquivo " << filePATH << std::endl;
+            return false;
+        }
+        this->batchBytes = std::max<size_t>(batchBytes, 4096);
+        cursor = file.data();
+        totalTriangles = countTriangles(file.data(), file.data() + file.size());
+
+        const size_t vertexBytes = 6 * sizeof(GLfloat);
+        streamMesh = Mesh();
+        glGenVertexArrays(1, &streamMesh.VAO);
+        glBindVertexArray(streamMesh.VAO);
+        glGenBuffers(1, &streamMesh.VBO);
+        glBindBuffer(GL_ARRAY_BUFFER, streamMesh.VBO);
+        glBufferData(GL_ARRAY_BUFFER, totalTriangles * 3 * vertexBytes, NULL, GL_STATIC_DRAW);
+        streamMesh.layout = objVertexLayout();
+        applyVertexLayout(streamMesh.layout);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return true;
+    }
+
+    // Lê e envia até `batches` lotes. Retorna false quando o arquivo acabou
+    bool step(int batches = 1)
+    {
+        if (!file.isOpen())
+            return false;
+
+        const char* end = file.data() + file.size();
+        for (int b = 0; b < batches && cursor < end; b++) {
+            // O lote termina depois do '\n' mais próximo de cursor + batchBytes
+            const char* cut = cursor + std::min(batchBytes, (size_t)(end - cursor));
+            if (cut < end) {
+                const char* nl = (const char*)std::memchr(cut, '\n', end - cut);
+                cut = nl ? nl + 1 : end;
+            }
+
+            parseOBJText(cursor, cut, data);
+            buildVertexBuffer(data, batch);
+            upload();
+            cursor = cut;
+
+            // Só as posições são necessárias para os próximos lotes
+            peakHostBytes = std::max(peakHostBytes, hostBytes());
+            data.corners.clear();
+            data.texCoords.clear();
+            data.normals.clear();
+            data.materialRuns.clear();
+        }
+
+        if (cursor >= end) {
+            // Libera as posições e o lote; o arquivo fica mapeado até close()
+            data = ObjData();
+            batch = std::vector<GLfloat>();
+            return false;
+        }
+        return true;
+    }
+
+    bool finished() const { return !file.isOpen() || cursor >= file.data() + file.size(); }
+
+    // Fração do arquivo já lida (0 a 1)
+    float progress() const
+    {
+        if (!file.isOpen() || file.size() == 0)
+            return 1.0f;
+        return (float)(cursor - file.data()) / (float)file.size();
+    }
+
+    Mesh& mesh() { return streamMesh; }
+    size_t trianglesLoaded() const { return (size_t)streamMesh.nVertices / 3; }
+    size_t trianglesTotal() const { return totalTriangles; }
+    // Maior uso de memória da CPU visto (posições + cantos + lote), em bytes
+    size_t peakHostMemory() const { return peakHostBytes; }
+
+    // Desmapeia o arquivo e solta os dados de CPU; a malha (GPU) continua válida
+    void close()
+    {
+        file.close();
+        data = ObjData();
+        batch = std::vector<GLfloat>();
+        cursor = NULL;
+    }
+
+private:
+    // Triângulos que o arquivo vai gerar: n - 2 por face de n cantos
+    static size_t countTriangles(const char* p, const char* end)
+    {
+        using namespace objparse;
+        size_t triangles = 0;
+        while (p < end) {
+            const char* lineEnd = (const char*)std::memchr(p, '\n', end - p);
+            if (!lineEnd)
+                lineEnd = end;
+            p = skipBlanks(p, lineEnd);
+            if (p + 1 < lineEnd && p[0] == 'f' && isBlank(p[1])) {
+                size_t corners = 0;
+                for (p = skipBlanks(p + 1, lineEnd); p < lineEnd; p = skipBlanks(p, lineEnd)) {
+                    p = skipToken(p, lineEnd);
+                    corners++;
+                }
+                if (corners >= 3)
+                    triangles += corners - 2;
+            }
+            p = lineEnd + 1;
+        }
+        return triangles;
+    }
+
+    void upload()
+    {
+        const size_t vertexBytes = 6 * sizeof(GLfloat);
+        size_t capacity = totalTriangles * 3;
+        size_t count = std::min(batch.size() / 6, capacity - (size_t)streamMesh.nVertices);
+        if (count == 0)
+            return;
+
+        glBindBuffer(GL_ARRAY_BUFFER, streamMesh.VBO);
+        glBufferSubData(GL_ARRAY_BUFFER, (size_t)streamMesh.nVertices * vertexBytes, count * vertexBytes, batch.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        streamMesh.nVertices += (GLsizei)count;
+    }
+
+    size_t hostBytes() const
+    {
+        return data.vertices.capacity() * sizeof(glm::vec3) + data.texCoords.capacity() * sizeof(glm::vec2) +
+               data.normals.capacity() * sizeof(glm::vec3) + data.corners.capacity() * sizeof(ObjIndex) +
+               batch.capacity() * sizeof(GLfloat);
+    }
+
+    MappedFile file;
+    const char* cursor = NULL;
+    size_t batchBytes = kDefaultBatchBytes;
+    size_t totalTriangles = 0;
+    size_t peakHostBytes = 0;
+    ObjData data;
+    std::vector<GLfloat> batch;
+    Mesh streamMesh;
+};
@@ -0,0 +1,197 @@
+/*
+ *  Pac-Man animado sem refazer geometria: cada Pac-Man é um disco inteiro (um
+ *  quadrado gerado de gl_VertexID, como no SpriteBatch.h) e a boca é recortada
+ *  no fragment shader, descartando os fragmentos fora do raio ou dentro da
+ *  fatia da boca. Abertura, velocidade de mastigar e giro são uniforms; o VBO
+ *  de instâncias (centro, raio, direção, fase e cor; 24 bytes) só é enviado
+ *  quando um Pac-Man muda, então animar milhares deles não envia nada por frame.
+ *
+ *  A abertura em cada instante é mouth * (0.5 - 0.5 cos(2 pi (time * chewRate
+ *  + phase))): fecha e abre chewRate vezes por segundo, cada Pac-Man na sua
+ *  fase. Com chewRate = 0 a boca fica parada, toda aberta. Ângulos em
+ *  radianos (0 = +x, anti-horário); a boca fica centrada na direção
+ *  facing + setFacing().
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  PacManRenderer pacmen;
+ *  pacmen.init();
+ *  pacmen.add(glm::vec2(0.0f, 0.0f), 0.5f, 0.0f, glm::vec3(1.0f, 1.0f, 0.0f));
+ *  pacmen.setMouth(1.5f);          // abertura máxima (radianos)
+ *  pacmen.setChewRate(3.0f);       // mastigadas por segundo
+ *  ...
+ *  pacmen.draw((float)glfwGetTime());
+ *  ...
+ *  pacmen.destroy();
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.h"
+#include "VertexFormat.h"
+
+// Uma instância do VBO
+struct PacManInstance
+{
+    glm::vec2 center;
+    float radius;
+    float facing;           // direção da boca (radianos)
+    float phase;            // defasagem da mastigada, em ciclos
+    uint32_t color;         // RGBA8
+};
+
+const char* const kPacManVertexShader = "#version 460 core\n"
+"layout (location = 0) in vec4 aPacMan;\n"   // centro xy, raio z, direção w
+"layout (location = 1) in float aPhase;\n"
+"layout (location = 2) in vec4 aColor;\n"
+"uniform float uTime;\n"
+"uniform float uMouth;\n"
+"uniform float uChewRate;\n"
+"uniform float uFacing;\n"
+"out vec2 local;\n"
+"out vec4 ourColor;\n"
+"flat out vec2 mouthDir;\n"
+"flat out float halfMouth;\n"
+"void main()\n"
+"{\n"
+"   local = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;\n"
+"   gl_Position = vec4(aPacMan.xy + local * aPacMan.z, 0.0, 1.0);\n"
+"   float open = uChewRate > 0.0 ? 0.5 - 0.5 * cos(6.2831853 * (uTime * uChewRate + aPhase)) : 1.0;\n"
+"   halfMouth = 0.5 * uMouth * open;\n"
+"   float facing = aPacMan.w + uFacing;\n"
+"   mouthDir = vec2(cos(facing), sin(facing));\n"
+"   ourColor = aColor;\n"
+"}\0";
+
+const char* const kPacManFragmentShader = "#version 460 core\n"
+"in vec2 local;\n"
+"in vec4 ourColor;\n"
+"flat in vec2 mouthDir;\n"
+"flat in float halfMouth;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   if (dot(local, local) > 1.0)\n"
+"       discard;\n"
+"   vec2 p = vec2(dot(local, mouthDir), dot(local, vec2(-mouthDir.y, mouthDir.x)));\n"
+"   if (abs(atan(p.y, p.x)) < halfMouth)\n"
+"       discard;\n"
+"   FragColor = ourColor;\n"
+"}\0";
+
+class PacManRenderer
+{
+public:
+    // Precisa do contexto ativo (compila o programa e cria o VAO)
+    bool init()
+    {
+        program = compileShaderProgram(kPacManVertexShader, kPacManFragmentShader);
+        if (!program)
+            return false;
+        timeLoc = glGetUniformLocation(program, "uTime");
+        mouthLoc = glGetUniformLocation(program, "uMouth");
+        chewRateLoc = glGetUniformLocation(program, "uChewRate");
+        facingLoc = glGetUniformLocation(program, "uFacing");
+
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        const GLsizei stride = sizeof(PacManInstance);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(PacManInstance, center));
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(PacManInstance, phase));
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid*)offsetof(PacManInstance, color));
+        for (GLuint location = 0; location < 3; location++) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+        glBindVertexArray(0);
+        return true;
+    }
+
+    // Retorna o índice do Pac-Man (para set)
+    size_t add(glm::vec2 center, float radius, float facing, glm::vec3 color, float phase = 0.0f)
+    {
+        instances.push_back(PacManInstance());
+        set(instances.size() - 1, center, radius, facing, color, phase);
+        return instances.size() - 1;
+    }
+
+    void set(size_t index, glm::vec2 center, float radius, float facing, glm::vec3 color, float phase = 0.0f)
+    {
+        PacManInstance& p = instances[index];
+        p.center = center;
+        p.radius = radius;
+        p.facing = facing;
+        p.phase = phase;
+        p.color = vertexpack::packRGBA8(glm::vec4(color, 1.0f));
+        dirty = true;
+    }
+
+    void clear()
+    {
+        instances.clear();
+        dirty = true;
+    }
+
+    size_t size() const { return instances.size(); }
+
+    // Abertura máxima da boca (radianos)
+    void setMouth(float aperture) { mouth = aperture; }
+    // Mastigadas por segundo (0: boca parada, toda aberta)
+    void setChewRate(float rate) { chewRate = rate; }
+    // Giro somado à direção de todos
+    void setFacing(float angle) { facing = angle; }
+
+    // Uma chamada para todos; só envia as instâncias se mudaram
+    void draw(float time)
+    {
+        if (instances.empty())
+            return;
+        if (dirty) {
+            glBindBuffer(GL_ARRAY_BUFFER, VBO);
+            glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(PacManInstance), instances.data(), GL_DYNAMIC_DRAW);
+            dirty = false;
+        }
+        glUseProgram(program);
+        glUniform1f(timeLoc, time);
+        glUniform1f(mouthLoc, mouth);
+        glUniform1f(chewRateLoc, chewRate);
+        glUniform1f(facingLoc, facing);
+        glBindVertexArray(VAO);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)instances.size());
+        glBindVertexArray(0);
+    }
+
+    void destroy()
+    {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteProgram(program);
+        VAO = VBO = program = 0;
+    }
+
+private:
+    std::vector<PacManInstance> instances;
+    GLuint program = 0;
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLint timeLoc = -1;
+    GLint mouthLoc = -1;
+    GLint chewRateLoc = -1;
+    GLint facingLoc = -1;
+    float mouth = 1.5f;
+    float chewRate = 3.0f;
+    float facing = 0.0f;
+    bool dirty = true;
+};
@@ -0,0 +1,212 @@
+/*
+ *  Formas geradas no vertex shader, sem VBO de vértices: círculos, arcos
+ *  (Pac-Man) e espirais descritos por parâmetros num shader storage buffer.
+ *  A instância (gl_InstanceID) escolhe a forma e o vértice (gl_VertexID) o
+ *  ponto da borda; o seno e o cosseno saem da GPU, e mudar as formas só
+ *  reenvia os parâmetros (32 bytes por forma), não os vértices.
+ *
+ *  Uma forma tem centro, raio inicial e final (iguais num círculo; diferentes
+ *  numa espiral, com o raio variando linearmente ao longo do ângulo), ângulo
+ *  inicial e final em radianos (0 = +x, anti-horário, como cos/sin) e o
+ *  número de segmentos. Preenchida, cada forma é um TRIANGLE_FAN (centro +
+ *  segments + 1 pontos); em contorno, um LINE_STRIP com os segments + 1 pontos.
+ *  Formas com menos segmentos que a maior repetem o último ponto (triângulos
+ *  degenerados), para que todas saiam na mesma chamada.
+ *
+ *  O buffer fica no ponto de ligação 0 de GL_SHADER_STORAGE_BUFFER (religado
+ *  a cada draw).
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  ProceduralShapes shapes;
+ *  shapes.init();
+ *  shapes.add(proceduralCircle(glm::vec2(0.0f), 0.5f, 8, shapeColor(glm::vec3(0.5f, 0.0f, 0.0f))));
+ *  ...
+ *  shapes.draw();                  // preenchidas; draw(false) para o contorno
+ *  ...
+ *  shapes.destroy();
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "GLExtensions.h"
+#include "ShaderProgram.h"
+#include "VertexFormat.h"
+
+// Parâmetros de uma forma (layout std430 do buffer, 32 bytes)
+struct ProceduralShape
+{
+    glm::vec2 center = glm::vec2(0.0f, 0.0f);
+    float radius = 0.5f;            // raio no ângulo inicial
+    float endRadius = 0.5f;         // raio no ângulo final
+    float startAngle = 0.0f;
+    float endAngle = 6.2831853f;
+    int32_t segments = 36;
+    uint32_t color = 0xFFFFFFFFu;   // RGBA8
+};
+
+// Cor RGBA8 de uma ProceduralShape (componentes em [0, 1])
+inline uint32_t shapeColor(glm::vec3 color, float alpha = 1.0f)
+{
+    return vertexpack::packRGBA8(glm::vec4(color, alpha));
+}
+
+inline ProceduralShape proceduralArc(glm::vec2 center, float radius, float startAngle, float endAngle, int segments,
+                                     uint32_t color)
+{
+    ProceduralShape shape;
+    shape.center = center;
+    shape.radius = radius;
+    shape.endRadius = radius;
+    shape.startAngle = startAngle;
+    shape.endAngle = endAngle;
+    shape.segments = std::max(1, segments);
+    shape.color = color;
+    return shape;
+}
+
+inline ProceduralShape proceduralCircle(glm::vec2 center, float radius, int segments, uint32_t color)
+{
+    return proceduralArc(center, radius, 0.0f, 6.2831853f, segments, color);
+}
+
+// O raio vai de startRadius a endRadius entre os dois ângulos (várias voltas: endAngle - startAngle > 2 pi)
+inline ProceduralShape proceduralSpiral(glm::vec2 center, float startRadius, float endRadius, float startAngle,
+                                        float endAngle, int segments, uint32_t color)
+{
+    ProceduralShape shape = proceduralArc(center, startRadius, startAngle, endAngle, segments, color);
+    shape.endRadius = endRadius;
+    return shape;
+}
+
+const char* const kShapeVertexShader = "#version 460 core\n"
+"struct Shape { vec4 circle; vec2 angles; int segments; uint color; };\n"   // circle: centro xy, raios zw
+"layout (std430, binding = 0) readonly buffer Shapes { Shape shapes[]; };\n"
+"uniform int uFilled;\n"                     // 1: vértice 0 é o centro (TRIANGLE_FAN)
+"out vec4 ourColor;\n"
+"void main()\n"
+"{\n"
+"   Shape s = shapes[gl_InstanceID];\n"
+"   int k = gl_VertexID - uFilled;\n"
+"   vec2 pos = s.circle.xy;\n"
+"   if (k >= 0) {\n"
+"       float t = float(min(k, s.segments)) / float(s.segments);\n"
+"       float a = mix(s.angles.x, s.angles.y, t);\n"
+"       pos += mix(s.circle.z, s.circle.w, t) * vec2(cos(a), sin(a));\n"
+"   }\n"
+"   gl_Position = vec4(pos, 0.0, 1.0);\n"
+"   ourColor = unpackUnorm4x8(s.color);\n"
+"}\0";
+
+const char* const kShapeFragmentShader = "#version 460 core\n"
+"in vec4 ourColor;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = ourColor;\n"
+"}\0";
+
+class ProceduralShapes
+{
+public:
+    // Precisa do contexto ativo (compila o programa e cria o VAO vazio e o buffer)
+    bool init()
+    {
+        program = compileShaderProgram(kShapeVertexShader, kShapeFragmentShader);
+        if (!program)
+            return false;
+        filledLoc = glGetUniformLocation(program, "uFilled");
+
+        // O perfil core não desenha sem VAO, mesmo sem atributos
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &SSBO);
+        return true;
+    }
+
+    // Retorna o índice da forma (para set)
+    size_t add(const ProceduralShape& shape)
+    {
+        shapes.push_back(shape);
+        dirty = true;
+        return shapes.size() - 1;
+    }
+
+    void set(size_t index, const ProceduralShape& shape)
+    {
+        shapes[index] = shape;
+        dirty = true;
+    }
+
+    const ProceduralShape& get(size_t index) const { return shapes[index]; }
+
+    void clear()
+    {
+        shapes.clear();
+        dirty = true;
+    }
+
+    size_t size() const { return shapes.size(); }
+
+    // Uma chamada para todas as formas
+    void draw(bool filled = true)
+    {
+        if (shapes.empty())
+            return;
+        if (dirty) {
+            maxSegments = 1;
+            for (ProceduralShape& shape : shapes) {
+                shape.segments = std::max(1, shape.segments);
+                maxSegments = std::max(maxSegments, shape.segments);
+            }
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, SSBO);
+            size_t bytes = shapes.size() * sizeof(ProceduralShape);
+            if (bytes > capacity) {
+                capacity = bytes;
+                glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, shapes.data(), GL_DYNAMIC_DRAW);
+            } else {
+                glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bytes, shapes.data());
+            }
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+            dirty = false;
+        }
+        glUseProgram(program);
+        glUniform1i(filledLoc, filled ? 1 : 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, SSBO);
+        glBindVertexArray(VAO);
+        if (filled)
+            glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, maxSegments + 2, (GLsizei)shapes.size());
+        else
+            glDrawArraysInstanced(GL_LINE_STRIP, 0, maxSegments + 1, (GLsizei)shapes.size());
+        glBindVertexArray(0);
+    }
+
+    void destroy()
+    {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &SSBO);
+        glDeleteProgram(program);
+        VAO = SSBO = program = 0;
+        capacity = 0;
+    }
+
+private:
+    std::vector<ProceduralShape> shapes;
+    GLuint program = 0;
+    GLuint VAO = 0;
+    GLuint SSBO = 0;
+    GLint filledLoc = -1;
+    GLint maxSegments = 1;
+    size_t capacity = 0;
+    bool dirty = true;
+};
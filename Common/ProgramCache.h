@@ -0,0 +1,233 @@
+/*
+ *  Cache em disco de programas GLSL já linkados: na primeira execução o
+ *  programa é compilado normalmente e o binário que o driver devolve
+ *  (glGetProgramBinary, OpenGL 4.1) é gravado em "<pasta>/<chave>.prog"; nas
+ *  seguintes, glProgramBinary carrega esse binário sem compilar nem linkar.
+ *
+ *  A chave é o hash dos fontes de cada estágio mais o do driver (GL_VENDOR,
+ *  GL_RENDERER, GL_VERSION e GL_SHADING_LANGUAGE_VERSION): mudar um shader
+ *  ou atualizar o driver gera outra chave, e os dois hashes ficam também no
+ *  cabeçalho do arquivo para conferir. Se o arquivo não existe, não confere
+ *  ou o driver recusa o binário (GL_LINK_STATUS falso depois do
+ *  glProgramBinary), o programa é compilado de novo e o arquivo refeito.
+ *  Sem OpenGL 4.1 / GL_ARB_get_program_binary ou sem nenhum formato de
+ *  binário no driver, só compila.
+ *
+ *  A pasta vem do RunMode.h (--shader-cache, padrão "shadercache" na pasta de
+ *  execução; --no-shader-cache desliga). Pasta vazia: só compila.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  GLuint program = loadCachedProgram(run.shaderCache, vertexShaderSource, fragmentShaderSource);
+ *  ...
+ *  glDeleteProgram(program);
+ *
+ *  ShaderProgram shader;
+ *  shader.adopt(loadCachedProgram(run.shaderCache, vertexShaderSource, fragmentShaderSource));
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+#include "FileCache.h"
+#include "GLExtensions.h"
+#include "MappedFile.h"
+#include "ShaderProgram.h"
+
+const char kProgramCacheMagic[4] = {'P', 'R', 'G', 'C'};
+const uint32_t kProgramCacheVersion = 1;
+
+// De onde veio o programa devolvido por loadCachedProgram
+enum class ProgramCacheResult
+{
+    Hit,        // binário do cache
+    Miss,       // compilado (e gravado para a próxima vez)
+    Disabled    // compilado, sem cache (pasta vazia ou driver sem binários)
+};
+
+struct ProgramCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t binaryFormat;          // o formato devolvido por glGetProgramBinary
+
+    uint64_t sourceHash;            // fontes dos estágios
+    uint64_t sourceBytes;
+    uint64_t driverHash;            // fabricante, renderer e versões
+
+    uint64_t dataOffset;
+    uint64_t dataBytes;
+};
+
+// Fontes dos estágios numa string só, com um separador que não aparece em GLSL
+// (sem geometry é diferente de geometry vazio)
+inline std::string programCacheSource(const char* vertexSource, const char* fragmentSource,
+                                      const char* geometrySource)
+{
+    std::string source = vertexSource;
+    source.push_back('\0');
+    source += fragmentSource;
+    if (geometrySource) {
+        source.push_back('\0');
+        source += geometrySource;
+    }
+    return source;
+}
+
+// Identifica o driver do contexto atual: o binário só vale para ele
+inline uint64_t programCacheDriverHash()
+{
+    static const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION};
+    std::string driver;
+    for (GLenum name : names) {
+        const char* value = (const char*)glGetString(name);
+        driver += value ? value : "";
+        driver.push_back('\n');
+    }
+    return hashBytes(driver.data(), driver.size());
+}
+
+// glProgramBinary existe e o driver tem ao menos um formato de binário
+inline bool programBinarySupported()
+{
+    if (!glextHasProgramBinary())
+        return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+inline std::string programCachePath(const std::string& cacheDir, uint64_t sourceHash, uint64_t driverHash)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.prog", (unsigned long long)(sourceHash ^ (driverHash * 31)));
+    return (std::filesystem::path(cacheDir) / name).string();
+}
+
+// Grava num temporário renomeado no fim, como o writeMeshCache
+inline bool writeProgramCache(const std::string& cachePath, GLuint program, uint64_t sourceHash, uint64_t sourceBytes,
+                              uint64_t driverHash)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+    std::vector<char> binary(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+        return false;
+
+    ProgramCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kProgramCacheMagic, 4);
+    header.version = kProgramCacheVersion;
+    header.headerSize = sizeof(ProgramCacheHeader);
+    header.binaryFormat = format;
+    header.sourceHash = sourceHash;
+    header.sourceBytes = sourceBytes;
+    header.driverHash = driverHash;
+    header.dataOffset = alignFileCache(sizeof(ProgramCacheHeader));
+    header.dataBytes = (uint64_t)written;
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+        const char padding[kFileCacheAlignment] = {};
+        out.write((const char*)&header, sizeof(header));
+        out.write(padding, header.dataOffset - sizeof(header));
+        out.write(binary.data(), header.dataBytes);
+        if (!out.good()) {
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Retorna 0 se o arquivo não existe, não confere ou o driver recusa o binário
+inline GLuint readProgramCache(const std::string& cachePath, uint64_t sourceHash, uint64_t sourceBytes,
+                               uint64_t driverHash)
+{
+    MappedFile file;
+    ProgramCacheHeader header;
+    if (!file.open(cachePath) || file.size() < sizeof(header))
+        return 0;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kProgramCacheMagic, 4) != 0 || header.version != kProgramCacheVersion ||
+        header.headerSize != sizeof(ProgramCacheHeader) || header.sourceHash != sourceHash ||
+        header.sourceBytes != sourceBytes || header.driverHash != driverHash || header.dataBytes == 0 ||
+        header.dataOffset + header.dataBytes > file.size())
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)header.binaryFormat, file.data() + header.dataOffset, (GLsizei)header.dataBytes);
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// Vertex + fragment (+ geometry, opcional), do cache ou compilado. Retorna 0 se o link falhar
+inline GLuint loadCachedProgram(const std::string& cacheDir, const char* vertexSource, const char* fragmentSource,
+                                const char* geometrySource = NULL, ProgramCacheResult* result = NULL)
+{
+    if (cacheDir.empty() || !programBinarySupported()) {
+        if (result)
+            *result = ProgramCacheResult::Disabled;
+        return compileShaderProgram(vertexSource, fragmentSource, geometrySource);
+    }
+
+    std::string source = programCacheSource(vertexSource, fragmentSource, geometrySource);
+    uint64_t sourceHash = hashBytes(source.data(), source.size());
+    uint64_t driverHash = programCacheDriverHash();
+    std::string cachePath = programCachePath(cacheDir, sourceHash, driverHash);
+
+    GLuint program = readProgramCache(cachePath, sourceHash, source.size(), driverHash);
+    if (program) {
+        if (result)
+            *result = ProgramCacheResult::Hit;
+        return program;
+    }
+
+    if (result)
+        *result = ProgramCacheResult::Miss;
+    program = glCreateProgram();
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    if (!linkShaderProgram(program, vertexSource, fragmentSource, geometrySource)) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    if (!writeProgramCache(cachePath, program, sourceHash, source.size(), driverHash))
+        std::cerr << "Aviso: nao foi possivel gravar " << cachePath << std::endl;
+    return program;
+}
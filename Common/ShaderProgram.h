@@ -0,0 +1,471 @@
+/*
+ *  Compilação de programas GLSL a partir de strings, com as mensagens de erro
+ *  no mesmo formato dos exercícios. Usado pelos renderizadores de Common/
+ *  (SpriteBatch.h...), que trazem os próprios shaders.
+ *
+ *  A classe ShaderProgram guarda o programa com a lista dos uniforms e blocos
+ *  ativos, lida uma vez depois do link (glGetProgramInterfaceiv, OpenGL 4.3
+ *  ou GL_ARB_program_interface_query; antes disso, glGetActiveUniform). Os
+ *  uniforms são pedidos pelo nome uma vez só e viram handles tipados; cada
+ *  handle lembra o último valor enviado e não envia de novo se o valor não
+ *  mudou. O envio usa glProgramUniform* (OpenGL 4.1), então não depende do
+ *  programa em uso. Os handles apontam para o ShaderProgram, que por isso
+ *  não pode ser copiado nem movido.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  GLuint program = compileShaderProgram(vertexShaderSource, fragmentShaderSource);
+ *  ...
+ *  glDeleteProgram(program);
+ *
+ *  ShaderProgram shader;
+ *  shader.build(vertexShaderSource, fragmentShaderSource);
+ *  ShaderUniformHandle<glm::vec4> color = shader.uniform<glm::vec4>("inputColor");
+ *  ...
+ *  color.set(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));  // só envia se mudou
+ *  shader.use();
+ *  ...
+ *  shader.destroy();
+ */
+
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "GLExtensions.h"
+
+// Compila um estágio; em caso de erro mostra o log e devolve o shader assim mesmo
+// (o link vai falhar e mostrar o erro também)
+inline GLuint compileShaderStage(GLenum type, const char* source)
+{
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    int success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        const char* stage = type == GL_VERTEX_SHADER ? "VERTEX" : type == GL_GEOMETRY_SHADER ? "GEOMETRY" : "FRAGMENT";
+        std::cout << "ERRO::SHADER::" << stage << "::COMPILACAO_FALHOU\n" << infoLog << std::endl;
+    }
+    return shader;
+}
+
+// Compila os estágios e linka num programa já criado, para quem precisa de
+// glProgramParameteri antes do link (ProgramCache.h). Falso se o link falhar
+inline bool linkShaderProgram(GLuint program, const char* vertexSource, const char* fragmentSource,
+                              const char* geometrySource = NULL)
+{
+    GLuint vertex = compileShaderStage(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragment = compileShaderStage(GL_FRAGMENT_SHADER, fragmentSource);
+    GLuint geometry = geometrySource ? compileShaderStage(GL_GEOMETRY_SHADER, geometrySource) : 0;
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    if (geometry)
+        glAttachShader(program, geometry);
+    glLinkProgram(program);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+    if (geometry)
+        glDeleteShader(geometry);
+
+    int success;
+    char infoLog[512];
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "ERRO::PROGRAMA::LINKAGEM_FALHOU\n" << infoLog << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Vertex + fragment (+ geometry, opcional). Retorna 0 se o link falhar
+inline GLuint compileShaderProgram(const char* vertexSource, const char* fragmentSource,
+                                   const char* geometrySource = NULL)
+{
+    GLuint program = glCreateProgram();
+    if (!linkShaderProgram(program, vertexSource, fragmentSource, geometrySource)) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// Uniform ativo, com o último valor enviado (vazio: nada enviado ainda)
+struct ShaderUniform
+{
+    std::string name;           // sem o "[0]" dos arrays
+    GLint location = -1;        // -1 nos uniforms de blocos
+    GLenum type = 0;
+    GLint arraySize = 1;
+    GLint blockIndex = -1;      // -1: fora de bloco
+    std::vector<unsigned char> value;
+};
+
+// Bloco de uniforms ou de shader storage ativo
+struct ShaderBlock
+{
+    std::string name;
+    GLenum programInterface = 0;    // GL_UNIFORM_BLOCK ou GL_SHADER_STORAGE_BLOCK
+    GLuint index = 0;
+    GLint binding = 0;
+    GLint dataSize = 0;
+};
+
+// Tipos GLSL aceitos por cada tipo C++ e as chamadas glUniform* (programa em
+// uso) e glProgramUniform* (OpenGL 4.1, qualquer programa) correspondentes
+template <typename T>
+struct UniformTraits;
+
+template <>
+struct UniformTraits<float>
+{
+    static bool accepts(GLenum type) { return type == GL_FLOAT; }
+    static void upload(GLint location, const float& v) { glUniform1f(location, v); }
+    static void upload(GLuint program, GLint location, const float& v) { glProgramUniform1f(program, location, v); }
+};
+
+// int também serve para bool e para a unidade de textura dos samplers
+template <>
+struct UniformTraits<int>
+{
+    static bool accepts(GLenum type)
+    {
+        static const GLenum samplers[] = {
+            GL_SAMPLER_1D, GL_SAMPLER_2D, GL_SAMPLER_3D, GL_SAMPLER_CUBE, GL_SAMPLER_2D_SHADOW, GL_SAMPLER_2D_ARRAY,
+            GL_SAMPLER_2D_ARRAY_SHADOW, GL_SAMPLER_CUBE_SHADOW, GL_SAMPLER_BUFFER, GL_SAMPLER_2D_RECT,
+            GL_SAMPLER_2D_MULTISAMPLE, GL_SAMPLER_CUBE_MAP_ARRAY, GL_INT_SAMPLER_2D, GL_INT_SAMPLER_3D,
+            GL_INT_SAMPLER_2D_ARRAY, GL_UNSIGNED_INT_SAMPLER_2D, GL_UNSIGNED_INT_SAMPLER_3D,
+            GL_UNSIGNED_INT_SAMPLER_2D_ARRAY};
+        if (type == GL_INT || type == GL_BOOL)
+            return true;
+        for (GLenum sampler : samplers) {
+            if (type == sampler)
+                return true;
+        }
+        return false;
+    }
+    static void upload(GLint location, const int& v) { glUniform1i(location, v); }
+    static void upload(GLuint program, GLint location, const int& v) { glProgramUniform1i(program, location, v); }
+};
+
+template <>
+struct UniformTraits<unsigned int>
+{
+    static bool accepts(GLenum type) { return type == GL_UNSIGNED_INT; }
+    static void upload(GLint location, const unsigned int& v) { glUniform1ui(location, v); }
+    static void upload(GLuint program, GLint location, const unsigned int& v)
+    {
+        glProgramUniform1ui(program, location, v);
+    }
+};
+
+template <>
+struct UniformTraits<glm::vec2>
+{
+    static bool accepts(GLenum type) { return type == GL_FLOAT_VEC2; }
+    static void upload(GLint location, const glm::vec2& v) { glUniform2fv(location, 1, &v[0]); }
+    static void upload(GLuint program, GLint location, const glm::vec2& v)
+    {
+        glProgramUniform2fv(program, location, 1, &v[0]);
+    }
+};
+
+template <>
+struct UniformTraits<glm::vec3>
+{
+    static bool accepts(GLenum type) { return type == GL_FLOAT_VEC3; }
+    static void upload(GLint location, const glm::vec3& v) { glUniform3fv(location, 1, &v[0]); }
+    static void upload(GLuint program, GLint location, const glm::vec3& v)
+    {
+        glProgramUniform3fv(program, location, 1, &v[0]);
+    }
+};
+
+template <>
+struct UniformTraits<glm::vec4>
+{
+    static bool accepts(GLenum type) { return type == GL_FLOAT_VEC4; }
+    static void upload(GLint location, const glm::vec4& v) { glUniform4fv(location, 1, &v[0]); }
+    static void upload(GLuint program, GLint location, const glm::vec4& v)
+    {
+        glProgramUniform4fv(program, location, 1, &v[0]);
+    }
+};
+
+template <>
+struct UniformTraits<glm::mat3>
+{
+    static bool accepts(GLenum type) { return type == GL_FLOAT_MAT3; }
+    static void upload(GLint location, const glm::mat3& v) { glUniformMatrix3fv(location, 1, GL_FALSE, &v[0][0]); }
+    static void upload(GLuint program, GLint location, const glm::mat3& v)
+    {
+        glProgramUniformMatrix3fv(program, location, 1, GL_FALSE, &v[0][0]);
+    }
+};
+
+template <>
+struct UniformTraits<glm::mat4>
+{
+    static bool accepts(GLenum type) { return type == GL_FLOAT_MAT4; }
+    static void upload(GLint location, const glm::mat4& v) { glUniformMatrix4fv(location, 1, GL_FALSE, &v[0][0]); }
+    static void upload(GLuint program, GLint location, const glm::mat4& v)
+    {
+        glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, &v[0][0]);
+    }
+};
+
+class ShaderProgram;
+
+// Handle de um uniform (o primeiro elemento, nos arrays). Um handle inválido
+// (uniform inexistente, otimizado fora ou de outro tipo) ignora set(), como
+// glUniform* com location -1
+template <typename T>
+struct ShaderUniformHandle
+{
+    ShaderProgram* program = NULL;
+    int index = -1;
+
+    bool valid() const { return program != NULL && index >= 0; }
+    // Vale para o programa do handle, esteja ele em uso ou não
+    void set(const T& value) const;
+};
+
+class ShaderProgram
+{
+public:
+    ShaderProgram() {}
+
+    // Os handles guardam o endereço do programa: nem cópia nem move
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+    // Vertex + fragment (+ geometry). Falha se o link falhar
+    bool build(const char* vertexSource, const char* fragmentSource, const char* geometrySource = NULL)
+    {
+        return adopt(compileShaderProgram(vertexSource, fragmentSource, geometrySource));
+    }
+
+    // Assume um programa já linkado (passa a ser dono dele: destroy() o apaga)
+    bool adopt(GLuint linked)
+    {
+        destroy();
+        program = linked;
+        if (!program)
+            return false;
+        directUpload = glextHasProgramUniform();
+        reflect();
+        return true;
+    }
+
+    void use() const { glUseProgram(program); }
+    GLuint id() const { return program; }
+
+    template <typename T>
+    ShaderUniformHandle<T> uniform(const std::string& name)
+    {
+        ShaderUniformHandle<T> handle;
+        std::map<std::string, size_t>::const_iterator it = indices.find(name);
+        if (it == indices.end())
+            return handle;
+        const ShaderUniform& u = uniforms[it->second];
+        if (u.location < 0)
+            return handle;
+        if (!UniformTraits<T>::accepts(u.type)) {
+            std::cout << "ERRO::PROGRAMA::UNIFORM_TIPO_ERRADO\n" << name << " (tipo GL 0x" << std::hex << u.type
+                      << std::dec << ")" << std::endl;
+            return handle;
+        }
+        handle.program = this;
+        handle.index = (int)it->second;
+        return handle;
+    }
+
+    // Envia só se o valor for diferente do último enviado por este handle. Vai
+    // sempre para este programa, mesmo com outro em uso: glProgramUniform* ou,
+    // sem ele, o programa é posto em uso só durante o glUniform*
+    template <typename T>
+    void set(const ShaderUniformHandle<T>& handle, const T& value)
+    {
+        if (!handle.valid())
+            return;
+        ShaderUniform& u = uniforms[handle.index];
+        if (u.value.size() == sizeof(T) && std::memcmp(u.value.data(), &value, sizeof(T)) == 0) {
+            skipped++;
+            return;
+        }
+        if (directUpload) {
+            UniformTraits<T>::upload(program, u.location, value);
+        } else {
+            GLint current = 0;
+            glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+            if ((GLuint)current != program)
+                glUseProgram(program);
+            UniformTraits<T>::upload(u.location, value);
+            if ((GLuint)current != program)
+                glUseProgram((GLuint)current);
+        }
+        u.value.assign((const unsigned char*)&value, (const unsigned char*)&value + sizeof(T));
+        uploads++;
+    }
+
+    // Esquece os valores lembrados (depois de glUniform* feito por fora)
+    void invalidateUniforms()
+    {
+        for (ShaderUniform& u : uniforms)
+            u.value.clear();
+    }
+
+    size_t uniformCount() const { return uniforms.size(); }
+    const ShaderUniform& uniformAt(size_t index) const { return uniforms[index]; }
+    size_t blockCount() const { return blocks.size(); }
+    const ShaderBlock& blockAt(size_t index) const { return blocks[index]; }
+
+    const ShaderBlock* block(const std::string& name) const
+    {
+        for (const ShaderBlock& b : blocks) {
+            if (b.name == name)
+                return &b;
+        }
+        return NULL;
+    }
+
+    // Liga um bloco de uniforms a um ponto de ligação de GL_UNIFORM_BUFFER
+    bool bindUniformBlock(const std::string& name, GLuint binding)
+    {
+        for (ShaderBlock& b : blocks) {
+            if (b.name == name && b.programInterface == GL_UNIFORM_BLOCK) {
+                glUniformBlockBinding(program, b.index, binding);
+                b.binding = (GLint)binding;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Chamadas glUniform* feitas e evitadas (valor repetido)
+    size_t uniformUploads() const { return uploads; }
+    size_t uniformSkips() const { return skipped; }
+
+    void destroy()
+    {
+        if (program)
+            glDeleteProgram(program);
+        program = 0;
+        uniforms.clear();
+        blocks.clear();
+        indices.clear();
+        uploads = skipped = 0;
+    }
+
+private:
+    void addUniform(const char* name, GLenum type, GLint arraySize, GLint location, GLint blockIndex)
+    {
+        ShaderUniform u;
+        u.name = name;
+        if (u.name.size() > 3 && u.name.compare(u.name.size() - 3, 3, "[0]") == 0)
+            u.name.erase(u.name.size() - 3);
+        u.type = type;
+        u.arraySize = arraySize;
+        u.location = location;
+        u.blockIndex = blockIndex;
+        indices[u.name] = uniforms.size();
+        uniforms.push_back(u);
+    }
+
+    void reflect()
+    {
+        uniforms.clear();
+        blocks.clear();
+        indices.clear();
+
+        if (glextHasProgramInterfaceQuery()) {
+            GLint count = 0, maxName = 0;
+            glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+            glGetProgramInterfaceiv(program, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxName);
+            std::vector<GLchar> name(maxName + 1, 0);
+            const GLenum props[] = {GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX};
+            for (GLint i = 0; i < count; i++) {
+                GLint values[4] = {0, 1, -1, -1};
+                glGetProgramResourceiv(program, GL_UNIFORM, (GLuint)i, 4, props, 4, NULL, values);
+                glGetProgramResourceName(program, GL_UNIFORM, (GLuint)i, (GLsizei)name.size(), NULL, name.data());
+                addUniform(name.data(), (GLenum)values[0], values[1], values[2], values[3]);
+            }
+
+            const GLenum interfaces[] = {GL_UNIFORM_BLOCK, GL_SHADER_STORAGE_BLOCK};
+            const GLenum blockProps[] = {GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE};
+            for (GLenum programInterface : interfaces) {
+                glGetProgramInterfaceiv(program, programInterface, GL_ACTIVE_RESOURCES, &count);
+                glGetProgramInterfaceiv(program, programInterface, GL_MAX_NAME_LENGTH, &maxName);
+                name.assign(maxName + 1, 0);
+                for (GLint i = 0; i < count; i++) {
+                    ShaderBlock b;
+                    GLint values[2] = {0, 0};
+                    glGetProgramResourceiv(program, programInterface, (GLuint)i, 2, blockProps, 2, NULL, values);
+                    glGetProgramResourceName(program, programInterface, (GLuint)i, (GLsizei)name.size(), NULL, name.data());
+                    b.name = name.data();
+                    b.programInterface = programInterface;
+                    b.index = (GLuint)i;
+                    b.binding = values[0];
+                    b.dataSize = values[1];
+                    blocks.push_back(b);
+                }
+            }
+            return;
+        }
+
+        // Antes da 4.3: glGetActiveUniform (2.0) e blocos de uniforms (3.1); sem shader storage
+        GLint count = 0, maxName = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxName);
+        std::vector<GLchar> name(maxName + 1, 0);
+        for (GLint i = 0; i < count; i++) {
+            GLint size = 1, blockIndex = -1;
+            GLenum type = 0;
+            GLuint index = (GLuint)i;
+            glGetActiveUniform(program, index, (GLsizei)name.size(), NULL, &size, &type, name.data());
+            glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+            addUniform(name.data(), type, size, glGetUniformLocation(program, name.data()), blockIndex);
+        }
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxName);
+        name.assign(maxName + 1, 0);
+        for (GLint i = 0; i < count; i++) {
+            ShaderBlock b;
+            glGetActiveUniformBlockName(program, (GLuint)i, (GLsizei)name.size(), NULL, name.data());
+            glGetActiveUniformBlockiv(program, (GLuint)i, GL_UNIFORM_BLOCK_BINDING, &b.binding);
+            glGetActiveUniformBlockiv(program, (GLuint)i, GL_UNIFORM_BLOCK_DATA_SIZE, &b.dataSize);
+            b.name = name.data();
+            b.programInterface = GL_UNIFORM_BLOCK;
+            b.index = (GLuint)i;
+            blocks.push_back(b);
+        }
+    }
+
+    GLuint program = 0;
+    std::vector<ShaderUniform> uniforms;
+    std::vector<ShaderBlock> blocks;
+    std::map<std::string, size_t> indices;
+    size_t uploads = 0;
+    size_t skipped = 0;
+    bool directUpload = false;  // glProgramUniform* disponível
+};
+
+template <typename T>
+inline void ShaderUniformHandle<T>::set(const T& value) const
+{
+    if (program)
+        program->set(*this, value);
+}
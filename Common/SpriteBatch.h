@@ -0,0 +1,173 @@
+/*
+ *  Desenho de sprites em lote: todos os sprites de uma textura (normalmente um
+ *  atlas, ver TextureAtlas.h) saem numa chamada só de glDrawArraysInstanced.
+ *
+ *  Cada sprite é uma instância de 40 bytes (centro, tamanho, região do atlas,
+ *  rotação e cor RGBA8) num VBO com divisor 1; o quadrado em si não tem VBO:
+ *  o vertex shader tira o canto de gl_VertexID (TRIANGLE_STRIP de 4 vértices).
+ *  A cada end() o VBO é realocado (glBufferData com NULL, para o driver não
+ *  esperar a GPU terminar o frame anterior) e preenchido com glBufferSubData.
+ *
+ *  As posições estão no mesmo espaço dos exercícios ([-1, 1] na tela), com
+ *  uma escala e um deslocamento opcionais (setTransform) para usar pixels ou
+ *  outra unidade. Os sprites são desenhados na ordem em que foram adicionados
+ *  (o último fica na frente), com mistura por alfa.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  SpriteBatch batch;
+ *  batch.init();
+ *  ...
+ *  batch.begin();
+ *  Sprite sprite;
+ *  sprite.position = glm::vec2(0.5f, -0.2f);
+ *  sprite.size = glm::vec2(0.1f, 0.1f);
+ *  sprite.uv = atlas.region("roda").uv;
+ *  batch.draw(sprite);
+ *  ...
+ *  batch.end(atlasTexture.id);      // uma chamada de desenho
+ *  ...
+ *  batch.destroy();
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.h"
+#include "VertexFormat.h"
+
+// Uma instância do VBO (layout usado pelo vertex shader abaixo)
+struct Sprite
+{
+    glm::vec2 position = glm::vec2(0.0f, 0.0f);     // centro
+    glm::vec2 size = glm::vec2(1.0f, 1.0f);         // largura e altura
+    glm::vec4 uv = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);   // (u0, v0, u1, v1), AtlasRegion::uv
+    float rotation = 0.0f;                          // radianos, anti-horário
+    uint32_t color = 0xFFFFFFFFu;                   // RGBA8, multiplica a textura
+};
+
+// Cor RGBA8 de um Sprite (componentes em [0, 1])
+inline uint32_t spriteColor(float r, float g, float b, float a = 1.0f)
+{
+    return vertexpack::packRGBA8(glm::vec4(r, g, b, a));
+}
+
+const char* const kSpriteVertexShader = "#version 460 core\n"
+"layout (location = 0) in vec4 aRect;\n"      // centro xy, tamanho zw
+"layout (location = 1) in vec4 aUV;\n"
+"layout (location = 2) in float aRotation;\n"
+"layout (location = 3) in vec4 aColor;\n"
+"uniform vec4 uTransform;\n"                  // escala xy, deslocamento zw
+"out vec2 texCoord;\n"
+"out vec4 spriteColor;\n"
+"void main()\n"
+"{\n"
+"   vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+"   vec2 local = (corner - 0.5) * aRect.zw;\n"
+"   float c = cos(aRotation), s = sin(aRotation);\n"
+"   vec2 world = aRect.xy + vec2(c * local.x - s * local.y, s * local.x + c * local.y);\n"
+"   gl_Position = vec4(world * uTransform.xy + uTransform.zw, 0.0, 1.0);\n"
+"   texCoord = mix(aUV.xy, aUV.zw, corner);\n"
+"   spriteColor = aColor;\n"
+"}\0";
+
+const char* const kSpriteFragmentShader = "#version 460 core\n"
+"in vec2 texCoord;\n"
+"in vec4 spriteColor;\n"
+"uniform sampler2D uTexture;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = texture(uTexture, texCoord) * spriteColor;\n"
+"}\0";
+
+class SpriteBatch
+{
+public:
+    // Precisa do contexto ativo (compila o programa e cria o VAO)
+    bool init()
+    {
+        program = compileShaderProgram(kSpriteVertexShader, kSpriteFragmentShader);
+        if (!program)
+            return false;
+        transformLoc = glGetUniformLocation(program, "uTransform");
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "uTexture"), 0);
+        glUseProgram(0);
+
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        const GLsizei stride = sizeof(Sprite);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(Sprite, position));
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(Sprite, uv));
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(Sprite, rotation));
+        glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid*)offsetof(Sprite, color));
+        for (GLuint location = 0; location < 4; location++) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+        glBindVertexArray(0);
+        return true;
+    }
+
+    // Posição na tela = posição * scale + offset
+    void setTransform(glm::vec2 scale, glm::vec2 offset) { transform = glm::vec4(scale.x, scale.y, offset.x, offset.y); }
+
+    void begin() { sprites.clear(); }
+    void draw(const Sprite& sprite) { sprites.push_back(sprite); }
+
+    // Envia os sprites e desenha todos com `texture`; retorna quantos foram desenhados
+    size_t end(GLuint texture)
+    {
+        if (sprites.empty())
+            return 0;
+
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        size_t bytes = sprites.size() * sizeof(Sprite);
+        if (bytes > capacity)
+            capacity = bytes;
+        glBufferData(GL_ARRAY_BUFFER, capacity, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, sprites.data());
+
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glUseProgram(program);
+        glUniform4f(transformLoc, transform.x, transform.y, transform.z, transform.w);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glBindVertexArray(VAO);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)sprites.size());
+        glBindVertexArray(0);
+        glDisable(GL_BLEND);
+        return sprites.size();
+    }
+
+    void destroy()
+    {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteProgram(program);
+        VAO = VBO = program = 0;
+        capacity = 0;
+    }
+
+private:
+    std::vector<Sprite> sprites;
+    GLuint program = 0;
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLint transformLoc = -1;
+    size_t capacity = 0;
+    glm::vec4 transform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+};
@@ -0,0 +1,251 @@
+/*
+ *  Atlas de texturas: várias imagens pequenas (sprites, partes de um desenho)
+ *  numa textura só, para que tudo seja desenhado sem trocar de textura (ver
+ *  SpriteBatch.h).
+ *
+ *  As imagens são arrumadas com MaxRects (melhor encaixe pelo lado menor): o
+ *  packer guarda os retângulos livres maximais, põe cada imagem (da maior para
+ *  a menor) no espaço livre que sobra menos num dos lados, e recorta os
+ *  retângulos livres que ela cobriu. O atlas começa com a menor potência de 2
+ *  que caberia pela área e dobra até caber tudo ou chegar em `maxSize`.
+ *
+ *  Em volta de cada imagem fica uma borda de `padding` pixels com as cores da
+ *  própria borda repetidas, para que a filtragem linear e os mipmaps não
+ *  misturem sprites vizinhos.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  TextureAtlas atlas;
+ *  atlas.add("parede", wallImage);             // TextureImage (TextureCache.h)
+ *  atlas.add("roda", wheelImage);
+ *  if (!atlas.build(4096)) { ...não coube... }
+ *  Texture texture;
+ *  atlas.upload(texture);
+ *  glm::vec4 uv = atlas.region("roda").uv;     // (u0, v0, u1, v1)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "TextureCache.h"
+
+struct AtlasRect
+{
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Posição de uma imagem no atlas, em pixels (sem a borda) e em coordenadas de textura
+struct AtlasRegion
+{
+    AtlasRect rect;
+    glm::vec4 uv;
+};
+
+// Retângulos livres maximais de uma área width x height
+class MaxRectsPacker
+{
+public:
+    void reset(int width, int height)
+    {
+        freeRects.clear();
+        AtlasRect all;
+        all.width = width;
+        all.height = height;
+        freeRects.push_back(all);
+    }
+
+    // Falha se não houver espaço livre para um retângulo de w x h
+    bool insert(int w, int h, AtlasRect& placed)
+    {
+        int bestShort = INT_MAX, bestLong = INT_MAX;
+        size_t best = freeRects.size();
+        for (size_t i = 0; i < freeRects.size(); i++) {
+            const AtlasRect& f = freeRects[i];
+            if (f.width < w || f.height < h)
+                continue;
+            int leftX = f.width - w, leftY = f.height - h;
+            int shortSide = std::min(leftX, leftY), longSide = std::max(leftX, leftY);
+            if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+                bestShort = shortSide;
+                bestLong = longSide;
+                best = i;
+            }
+        }
+        if (best == freeRects.size())
+            return false;
+
+        placed.x = freeRects[best].x;
+        placed.y = freeRects[best].y;
+        placed.width = w;
+        placed.height = h;
+
+        // Cada livre que cruza o novo retângulo vira até 4 livres (as sobras em volta)
+        std::vector<AtlasRect> kept, split;
+        for (const AtlasRect& f : freeRects) {
+            if (!intersects(f, placed)) {
+                kept.push_back(f);
+                continue;
+            }
+            if (placed.x > f.x)
+                split.push_back({f.x, f.y, placed.x - f.x, f.height});
+            if (placed.x + placed.width < f.x + f.width)
+                split.push_back({placed.x + placed.width, f.y, f.x + f.width - placed.x - placed.width, f.height});
+            if (placed.y > f.y)
+                split.push_back({f.x, f.y, f.width, placed.y - f.y});
+            if (placed.y + placed.height < f.y + f.height)
+                split.push_back({f.x, placed.y + placed.height, f.width, f.y + f.height - placed.y - placed.height});
+        }
+
+        // Só os maximais. Os que não foram cortados já eram maximais entre si e
+        // nenhum cabe numa sobra (que está dentro de um livre antigo): basta
+        // tirar as sobras contidas em outro retângulo
+        freeRects.swap(kept);
+        size_t keptCount = freeRects.size();
+        for (size_t i = 0; i < split.size(); i++) {
+            bool contained = false;
+            for (size_t j = 0; j < split.size() && !contained; j++)
+                contained = i != j && contains(split[j], split[i]) && (!contains(split[i], split[j]) || j < i);
+            for (size_t j = 0; j < keptCount && !contained; j++)
+                contained = contains(freeRects[j], split[i]);
+            if (!contained)
+                freeRects.push_back(split[i]);
+        }
+        return true;
+    }
+
+private:
+    static bool intersects(const AtlasRect& a, const AtlasRect& b)
+    {
+        return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+
+    static bool contains(const AtlasRect& outer, const AtlasRect& inner)
+    {
+        return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width &&
+               inner.y + inner.height <= outer.y + outer.height;
+    }
+
+    std::vector<AtlasRect> freeRects;
+};
+
+class TextureAtlas
+{
+public:
+    // Copia a imagem (RGBA8); um nome repetido substitui a imagem anterior
+    void add(const std::string& name, const TextureImage& image)
+    {
+        std::map<std::string, size_t>::iterator it = indices.find(name);
+        if (it != indices.end()) {
+            images[it->second] = image;
+            return;
+        }
+        indices[name] = images.size();
+        names.push_back(name);
+        images.push_back(image);
+    }
+
+    // Arruma as imagens e monta os pixels do atlas. Falha se não couberem em maxSize x maxSize
+    bool build(int maxSize = 4096, int padding = 2)
+    {
+        std::vector<size_t> order(images.size());
+        long long area = 0;
+        for (size_t i = 0; i < images.size(); i++) {
+            order[i] = i;
+            area += (long long)(images[i].width + 2 * padding) * (images[i].height + 2 * padding);
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            int sa = std::max(images[a].width, images[a].height), sb = std::max(images[b].width, images[b].height);
+            return sa != sb ? sa > sb : a < b;
+        });
+
+        int width = 1, height = 1;
+        while ((long long)width * height < area) {
+            if (width <= height)
+                width *= 2;
+            else
+                height *= 2;
+        }
+        regions.assign(images.size(), AtlasRegion());
+        for (;;) {
+            if (width > maxSize || height > maxSize)
+                return false;
+            MaxRectsPacker packer;
+            packer.reset(width, height);
+            bool fits = true;
+            for (size_t k = 0; k < order.size() && fits; k++) {
+                const TextureImage& image = images[order[k]];
+                AtlasRect placed;
+                fits = packer.insert(image.width + 2 * padding, image.height + 2 * padding, placed);
+                regions[order[k]].rect = {placed.x + padding, placed.y + padding, image.width, image.height};
+            }
+            if (fits)
+                break;
+            if (width <= height)
+                width *= 2;
+            else
+                height *= 2;
+        }
+
+        pixels.width = width;
+        pixels.height = height;
+        pixels.pixels.assign((size_t)width * height * 4, 0);
+        for (size_t i = 0; i < images.size(); i++) {
+            AtlasRegion& region = regions[i];
+            blit(images[i], region.rect, padding);
+            region.uv = glm::vec4((float)region.rect.x / width, (float)region.rect.y / height,
+                                  (float)(region.rect.x + region.rect.width) / width,
+                                  (float)(region.rect.y + region.rect.height) / height);
+        }
+        return true;
+    }
+
+    // Pixels montados por build(), nas mesmas convenções da TextureImage
+    const TextureImage& image() const { return pixels; }
+
+    size_t size() const { return images.size(); }
+    const std::string& name(size_t index) const { return names[index]; }
+    const AtlasRegion& region(size_t index) const { return regions[index]; }
+    const AtlasRegion& region(const std::string& name) const { return regions[indices.at(name)]; }
+    bool contains(const std::string& name) const { return indices.count(name) != 0; }
+
+    // Sem repetição nas bordas do atlas (cada sprite já tem a própria borda)
+    void upload(Texture& texture, TextureOptions options = TextureOptions()) const
+    {
+        options.wrap = GL_CLAMP_TO_EDGE;
+        uploadTexture(pixels, texture, options);
+    }
+
+private:
+    // Copia a imagem e repete a primeira/última linha e coluna na borda
+    void blit(const TextureImage& image, const AtlasRect& rect, int padding)
+    {
+        if (image.width <= 0 || image.height <= 0)
+            return;
+        for (int y = -padding; y < image.height + padding; y++) {
+            int sy = std::min(std::max(y, 0), image.height - 1);
+            for (int x = -padding; x < image.width + padding; x++) {
+                int sx = std::min(std::max(x, 0), image.width - 1);
+                std::memcpy(&pixels.pixels[((size_t)(rect.y + y) * pixels.width + rect.x + x) * 4],
+                            &image.pixels[((size_t)sy * image.width + sx) * 4], 4);
+            }
+        }
+    }
+
+    std::vector<std::string> names;
+    std::vector<TextureImage> images;
+    std::map<std::string, size_t> indices;
+    std::vector<AtlasRegion> regions;
+    TextureImage pixels;
+};
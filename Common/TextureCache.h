@@ -0,0 +1,493 @@
+/*
+ *  Texturas 2D a partir de imagens (.png, .jpg... via stb_image), com um
+ *  cache por caminho: pedir a mesma imagem de novo devolve o mesmo
+ *  AsyncTexture (o mesmo nome de textura OpenGL), sem decodificar nem enviar
+ *  outra vez.
+ *
+ *  A carga segue as etapas do AssetLoader (AssetLoader.h):
+ *    1. decode - stb_image num worker, sempre para RGBA8 (e invertida na
+ *                vertical, porque o OpenGL começa a imagem por baixo);
+ *    2. upload - no contexto compartilhado: glTexStorage2D com todos os
+ *                níveis de mipmap (armazenamento imutável), os pixels
+ *                copiados para um PBO (pixel buffer object) e de lá para o
+ *                nível 0 com glTexSubImage2D, sem a cópia síncrona que o
+ *                driver faria a partir da memória do programa, e glGenerateMipmap;
+ *    3. finish - nada a fazer na thread principal além de marcar como pronta.
+ *  Sem glTexStorage2D (OpenGL < 4.2, ver GLExtensions.h), cada nível é
+ *  alocado com glTexImage2D.
+ *
+ *  Com TextureOptions::compression (BC1, BC3 ou BC7, ver TextureCompress.h),
+ *  a primeira carga comprime a imagem e a cadeia de mipmaps na CPU e grava
+ *  "<imagem>.bc1" (ou .bc3/.bc7) ao lado dela; nas seguintes, o decode só lê
+ *  esse arquivo (nada de PNG) e o upload envia os blocos com
+ *  glCompressedTexSubImage2D. O arquivo é refeito se a imagem mudar (mesma
+ *  regra do MeshCache.h) e o texcompress gera os arquivos antes, fora do
+ *  programa. Se o driver não tiver o formato, BC7 cai para BC3 e BC1/BC3 para
+ *  RGBA8 sem compressão.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  AssetLoader loader;
+ *  loader.start(run, window);
+ *  TextureCache textures(loader);
+ *  std::shared_ptr<AsyncTexture> wall = textures.load("../assets/tex/pixelWall.png");
+ *  ...
+ *  loader.poll();
+ *  if (wall->ready())
+ *      glBindTexture(GL_TEXTURE_2D, wall->texture.id);
+ *  ...
+ *  loader.stop();
+ *  textures.destroy();
+ *
+ *  loadTexture faz o mesmo de forma síncrona, sem AssetLoader nem cache.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+// stb_image (baixada pelo CMake); a implementação fica neste cabeçalho
+#ifndef TEXTURE_CACHE_NO_STB_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#endif
+#include <stb_image.h>
+
+#include "AssetLoader.h"
+#include "FileCache.h"
+#include "GLExtensions.h"
+#include "MappedFile.h"
+#include "TextureCompress.h"
+
+struct TextureOptions
+{
+    bool srgb = false;              // cores em sRGB (GL_SRGB8_ALPHA8); falso para mapas de dados
+    bool mipmaps = true;
+    bool flipVertically = true;
+    GLint wrap = GL_REPEAT;
+    GLint magFilter = GL_LINEAR;    // GL_NEAREST para pixel art (ex.: pixelWall.png)
+    TextureCompression compression = TextureCompression::None;
+};
+
+// Textura na GPU
+struct Texture
+{
+    GLuint id = 0;
+    int width = 0;
+    int height = 0;
+    int levels = 0;
+    GLenum format = 0;              // formato interno (GL_RGBA8, GL_COMPRESSED_...)
+    size_t bytes = 0;               // memória de vídeo de todos os níveis
+};
+
+// Pixels RGBA8 decodificados, linha por linha a partir de baixo
+struct TextureImage
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+struct AsyncTexture : Asset
+{
+    Texture texture;
+};
+
+// Níveis de uma cadeia de mipmaps completa (até 1x1)
+inline int textureMipLevels(int width, int height)
+{
+    int levels = 1;
+    for (int size = std::max(width, height); size > 1; size >>= 1)
+        levels++;
+    return levels;
+}
+
+// Só CPU: pode rodar em qualquer thread
+inline bool decodeTexture(const std::string& path, TextureImage& image, bool flipVertically = true)
+{
+    int channels = 0;
+    unsigned char* data = stbi_load(path.c_str(), &image.width, &image.height, &channels, 4);
+    if (!data) {
+        std::cerr << "Erro ao decodificar " << path << ": " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    size_t rowBytes = (size_t)image.width * 4;
+    image.pixels.resize(rowBytes * image.height);
+    for (int y = 0; y < image.height; y++) {
+        int src = flipVertically ? image.height - 1 - y : y;
+        std::memcpy(&image.pixels[y * rowBytes], data + src * rowBytes, rowBytes);
+    }
+    stbi_image_free(data);
+    return true;
+}
+
+// Cria a textura e envia o nível 0 por um PBO; com mipmaps, gera os outros níveis
+inline void uploadTexture(const TextureImage& image, Texture& texture, const TextureOptions& options = TextureOptions())
+{
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.levels = options.mipmaps ? textureMipLevels(image.width, image.height) : 1;
+    GLenum internalFormat = options.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+    texture.format = internalFormat;
+    texture.bytes = 0;
+    for (int level = 0; level < texture.levels; level++)
+        texture.bytes += (size_t)std::max(1, image.width >> level) * std::max(1, image.height >> level) * 4;
+
+    glGenTextures(1, &texture.id);
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    if (glextHasTextureStorage()) {
+        glTexStorage2D(GL_TEXTURE_2D, texture.levels, internalFormat, image.width, image.height);
+    } else {
+        for (int level = 0; level < texture.levels; level++)
+            glTexImage2D(GL_TEXTURE_2D, level, internalFormat, std::max(1, image.width >> level),
+                         std::max(1, image.height >> level), 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture.levels - 1);
+
+    GLuint pbo;
+    glGenBuffers(1, &pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, image.pixels.size(), NULL, GL_STREAM_DRAW);
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, image.pixels.size(),
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (dst) {
+        std::memcpy(dst, image.pixels.data(), image.pixels.size());
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    } else {
+        glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, image.pixels.size(), image.pixels.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width, image.height, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    // O driver só libera o PBO depois que a cópia terminar
+    glDeleteBuffers(1, &pbo);
+
+    if (texture.levels > 1)
+        glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture.levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, options.magFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, options.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, options.wrap);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Arquivo de blocos comprimidos: TextureCacheHeader e depois os níveis em
+// sequência (CompressedImage::data), alinhados em 16 bytes
+const char kTextureCacheMagic[4] = {'T', 'E', 'X', 'C'};
+const uint32_t kTextureCacheVersion = 1;
+
+// Bits de TextureCacheHeader::flags
+const uint32_t kTextureCacheFlipped = 1;
+const uint32_t kTextureCacheMipmaps = 2;
+
+struct TextureCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t flags;
+
+    uint64_t sourceSize;            // imagem de origem
+    int64_t sourceTime;
+    uint64_t sourceHash;
+
+    uint32_t format;                // TextureCompression
+    uint32_t width;
+    uint32_t height;
+    uint32_t levels;
+    uint64_t dataOffset;
+    uint64_t dataBytes;
+};
+
+inline std::string compressedTexturePath(const std::string& sourcePath, TextureCompression format)
+{
+    return sourcePath + "." + textureCompressionName(format);
+}
+
+inline uint32_t textureCacheFlags(const TextureOptions& options)
+{
+    return (options.flipVertically ? kTextureCacheFlipped : 0) | (options.mipmaps ? kTextureCacheMipmaps : 0);
+}
+
+// Grava num temporário renomeado no fim, como o writeMeshCache
+inline bool writeCompressedTexture(const std::string& cachePath, const std::string& sourcePath,
+                                   const CompressedImage& image, uint32_t flags)
+{
+    FileCacheSource source;
+    if (!statCacheSource(sourcePath, source))
+        return false;
+
+    TextureCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kTextureCacheMagic, 4);
+    header.version = kTextureCacheVersion;
+    header.headerSize = sizeof(TextureCacheHeader);
+    header.flags = flags;
+    header.sourceSize = source.size;
+    header.sourceTime = source.time;
+    header.sourceHash = hashCacheSource(sourcePath);
+    header.format = (uint32_t)image.format;
+    header.width = (uint32_t)image.width;
+    header.height = (uint32_t)image.height;
+    header.levels = (uint32_t)image.levels;
+    header.dataOffset = alignFileCache(sizeof(TextureCacheHeader));
+    header.dataBytes = image.data.size();
+
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+        const char padding[kFileCacheAlignment] = {};
+        out.write((const char*)&header, sizeof(header));
+        out.write(padding, header.dataOffset - sizeof(header));
+        out.write((const char*)image.data.data(), header.dataBytes);
+        if (!out.good()) {
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Falha se o arquivo não existe, está corrompido ou não corresponde à imagem de origem
+inline bool readCompressedTexture(const std::string& cachePath, const std::string& sourcePath,
+                                  TextureCompression format, uint32_t flags, CompressedImage& image)
+{
+    MappedFile file;
+    TextureCacheHeader header;
+    if (!file.open(cachePath) || file.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kTextureCacheMagic, 4) != 0 || header.version != kTextureCacheVersion ||
+        header.headerSize != sizeof(TextureCacheHeader) || header.flags != flags ||
+        header.format != (uint32_t)format || header.levels == 0 || header.levels > 32)
+        return false;
+
+    image.format = format;
+    image.width = (int)header.width;
+    image.height = (int)header.height;
+    image.levels = (int)header.levels;
+    if (header.dataBytes != image.levelOffset(image.levels) || header.dataOffset + header.dataBytes > file.size())
+        return false;
+
+    FileCacheSource source;
+    if (!statCacheSource(sourcePath, source) || source.size != header.sourceSize)
+        return false;
+    if (source.time != header.sourceTime) {
+        if (hashCacheSource(sourcePath) != header.sourceHash)
+            return false;
+        updateCacheSourceTime(cachePath, offsetof(TextureCacheHeader, sourceTime), source.time);
+    }
+
+    const unsigned char* data = (const unsigned char*)file.data() + header.dataOffset;
+    image.data.assign(data, data + header.dataBytes);
+    return true;
+}
+
+// Só CPU: lê o arquivo comprimido ou, se não houver um válido, decodifica a
+// imagem, comprime e grava o arquivo para a próxima vez
+inline bool decodeCompressedTexture(const std::string& path, const TextureOptions& options, CompressedImage& image,
+                                    int threads = 1)
+{
+    std::string cachePath = compressedTexturePath(path, options.compression);
+    uint32_t flags = textureCacheFlags(options);
+    if (readCompressedTexture(cachePath, path, options.compression, flags, image))
+        return true;
+
+    TextureImage rgba;
+    if (!decodeTexture(path, rgba, options.flipVertically))
+        return false;
+    compressTexture(rgba.pixels.data(), rgba.width, rgba.height, options.compression, options.mipmaps, image, threads);
+    if (!writeCompressedTexture(cachePath, path, image, flags))
+        std::cerr << "Aviso: nao foi possivel gravar " << cachePath << std::endl;
+    return true;
+}
+
+inline GLenum compressedInternalFormat(TextureCompression format, bool srgb)
+{
+    switch (format) {
+    case TextureCompression::BC1:
+        return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case TextureCompression::BC3:
+        return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case TextureCompression::BC7:
+        return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    default:
+        return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+    }
+}
+
+// Formato que o contexto atual aceita: BC7 -> BC3 -> sem compressão
+inline TextureCompression resolveTextureCompression(TextureCompression format)
+{
+    if (format == TextureCompression::BC7 && !glextVersion(4, 2) && !glextSupported("GL_ARB_texture_compression_bptc"))
+        format = TextureCompression::BC3;
+    if ((format == TextureCompression::BC1 || format == TextureCompression::BC3) &&
+        !glextSupported("GL_EXT_texture_compression_s3tc"))
+        format = TextureCompression::None;
+    return format;
+}
+
+// Como o uploadTexture, mas com os blocos de todos os níveis já prontos
+inline void uploadCompressedTexture(const CompressedImage& image, Texture& texture,
+                                    const TextureOptions& options = TextureOptions())
+{
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.levels = image.levels;
+    texture.format = compressedInternalFormat(image.format, options.srgb);
+    texture.bytes = image.data.size();
+
+    glGenTextures(1, &texture.id);
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    bool storage = glextHasTextureStorage();
+    if (storage)
+        glTexStorage2D(GL_TEXTURE_2D, image.levels, texture.format, image.width, image.height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.levels - 1);
+
+    GLuint pbo;
+    glGenBuffers(1, &pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, image.data.size(), image.data.data(), GL_STREAM_DRAW);
+    for (int level = 0; level < image.levels; level++) {
+        GLvoid* offset = (GLvoid*)image.levelOffset(level);
+        GLsizei w = image.levelWidth(level), h = image.levelHeight(level), bytes = (GLsizei)image.levelBytes(level);
+        if (storage)
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, w, h, texture.format, bytes, offset);
+        else
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, texture.format, w, h, 0, bytes, offset);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glDeleteBuffers(1, &pbo);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, image.levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, options.magFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, options.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, options.wrap);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Versão síncrona (decode + upload na thread atual)
+inline bool loadTexture(const std::string& path, Texture& texture, const TextureOptions& options = TextureOptions())
+{
+    TextureOptions resolved = options;
+    resolved.compression = resolveTextureCompression(options.compression);
+    if (resolved.compression != TextureCompression::None) {
+        CompressedImage image;
+        if (!decodeCompressedTexture(path, resolved, image))
+            return false;
+        uploadCompressedTexture(image, texture, resolved);
+        return true;
+    }
+
+    TextureImage image;
+    if (!decodeTexture(path, image, options.flipVertically))
+        return false;
+    uploadTexture(image, texture, options);
+    return true;
+}
+
+inline void destroyTexture(Texture& texture)
+{
+    if (texture.id)
+        glDeleteTextures(1, &texture.id);
+    texture = Texture();
+}
+
+// Cache de texturas por caminho, carregadas pelo AssetLoader. Usar só na
+// thread principal; a primeira carga de um caminho define as opções dele
+class TextureCache
+{
+public:
+    explicit TextureCache(AssetLoader& loader) : loader(loader) {}
+
+    std::shared_ptr<AsyncTexture> load(const std::string& path, const TextureOptions& options = TextureOptions())
+    {
+        requestCount++;
+        std::map<std::string, std::shared_ptr<AsyncTexture>>::iterator it = textures.find(path);
+        if (it != textures.end())
+            return it->second;
+
+        std::shared_ptr<AsyncTexture> asset = std::make_shared<AsyncTexture>();
+        asset->path = path;
+        textures[path] = asset;
+
+        // O formato comprimido depende do driver: decidido aqui, com o contexto principal
+        TextureOptions resolved = options;
+        resolved.compression = resolveTextureCompression(options.compression);
+        std::atomic<int>* decoded = &decodeCount;
+        if (resolved.compression != TextureCompression::None) {
+            std::shared_ptr<CompressedImage> image = std::make_shared<CompressedImage>();
+            auto decode = [=]() {
+                (*decoded)++;
+                return decodeCompressedTexture(path, resolved, *image);
+            };
+            auto upload = [=]() {
+                uploadCompressedTexture(*image, asset->texture, resolved);
+                *image = CompressedImage();
+                return true;
+            };
+            loader.submit(asset, decode, upload, []() {});
+            return asset;
+        }
+
+        std::shared_ptr<TextureImage> image = std::make_shared<TextureImage>();
+        auto decode = [=]() {
+            (*decoded)++;
+            return decodeTexture(path, *image, resolved.flipVertically);
+        };
+        auto upload = [=]() {
+            uploadTexture(*image, asset->texture, resolved);
+            *image = TextureImage();
+            return true;
+        };
+        loader.submit(asset, decode, upload, []() {});
+        return asset;
+    }
+
+    // Texturas distintas, pedidos (com repetições) e decodificações feitas
+    size_t size() const { return textures.size(); }
+    int requests() const { return requestCount; }
+    int decodes() const { return decodeCount; }
+
+    // Apaga as texturas prontas; chamar depois de loader.stop()
+    void destroy()
+    {
+        for (auto& entry : textures)
+            if (entry.second->ready())
+                destroyTexture(entry.second->texture);
+        textures.clear();
+    }
+
+private:
+    AssetLoader& loader;
+    std::map<std::string, std::shared_ptr<AsyncTexture>> textures;
+    int requestCount = 0;
+    std::atomic<int> decodeCount{0};
+};
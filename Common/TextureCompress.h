@@ -0,0 +1,543 @@
+/*
+ *  Compressão de texturas em blocos (BCn) na CPU, com a cadeia de mipmaps.
+ *
+ *  Cada bloco de 4x4 pixels vira 8 ou 16 bytes, no formato que a GPU lê
+ *  direto (sem descompactar na memória de vídeo):
+ *    BC1 (DXT1)  8 bytes   RGB, 2 cores 5:6:5 + 2 bits por pixel       (8x menor que RGBA8)
+ *    BC3 (DXT5)  16 bytes  BC1 para a cor + alfa com 8 níveis por bloco (4x menor)
+ *    BC7 (BPTC)  16 bytes  RGBA, modo 6: 2 cores RGBA 7777 + bit p,    (4x menor, melhor qualidade)
+ *                          16 níveis por pixel; se o alfa varia no bloco, testa
+ *                          também o modo 5 (cor RGB 777 e alfa 8 bits em retas
+ *                          separadas, 4 níveis cada) e fica com o de menor erro
+ *  As cores de cada bloco são aproximadas por um segmento de reta: o eixo
+ *  principal (PCA) das cores dá a direção, os extremos da projeção dão as
+ *  pontas, e depois os extremos são reajustados por mínimos quadrados com os
+ *  índices escolhidos. Não é o encoder mais caprichado (não testa partições
+ *  do BC7, por exemplo), mas roda rápido o bastante para ser feito na
+ *  primeira carga, e o resultado fica num cache (ver TextureCache.h).
+ *
+ *  Só CPU: pode rodar em qualquer thread, sem contexto OpenGL.
+ *
+ *  Forma de uso:
+ *  -----------------
+ *  CompressedImage bc;
+ *  compressTexture(rgba, width, height, TextureCompression::BC7, true, bc);
+ *  for (int level = 0; level < bc.levels; level++)
+ *      ... bc.level(level), bc.levelBytes(level) ...
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "ThreadPool.h"
+
+enum class TextureCompression : uint32_t { None, BC1, BC3, BC7 };
+
+inline const char* textureCompressionName(TextureCompression format)
+{
+    static const char* const kNames[] = {"rgba8", "bc1", "bc3", "bc7"};
+    return kNames[(int)format];
+}
+
+inline size_t compressedBlockBytes(TextureCompression format)
+{
+    return format == TextureCompression::BC1 ? 8 : 16;
+}
+
+// Blocos incompletos (bordas, níveis menores que 4x4) ocupam um bloco inteiro
+inline size_t compressedLevelBytes(TextureCompression format, int width, int height)
+{
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * compressedBlockBytes(format);
+}
+
+// Níveis 0..levels-1 em sequência, cada um com o tamanho de compressedLevelBytes
+struct CompressedImage
+{
+    TextureCompression format = TextureCompression::None;
+    int width = 0;
+    int height = 0;
+    int levels = 0;
+    std::vector<unsigned char> data;
+
+    int levelWidth(int level) const { return std::max(1, width >> level); }
+    int levelHeight(int level) const { return std::max(1, height >> level); }
+    size_t levelBytes(int level) const { return compressedLevelBytes(format, levelWidth(level), levelHeight(level)); }
+
+    size_t levelOffset(int level) const
+    {
+        size_t offset = 0;
+        for (int l = 0; l < level; l++)
+            offset += levelBytes(l);
+        return offset;
+    }
+
+    const unsigned char* level(int level) const { return data.data() + levelOffset(level); }
+};
+
+namespace bcn
+{
+    // Pesos da interpolação do BC7 com índices de 4 bits (em 64 avos)
+    const int kWeights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    // Bloco 4x4 a partir de (x, y), repetindo a última linha/coluna nas bordas
+    inline void fetchBlock(const unsigned char* rgba, int width, int height, int x, int y, float pixels[16][4])
+    {
+        for (int j = 0; j < 4; j++) {
+            const unsigned char* row = rgba + (size_t)std::min(y + j, height - 1) * width * 4;
+            for (int i = 0; i < 4; i++) {
+                const unsigned char* p = row + std::min(x + i, width - 1) * 4;
+                for (int c = 0; c < 4; c++)
+                    pixels[j * 4 + i][c] = (float)p[c];
+            }
+        }
+    }
+
+    // Centro e eixo principal dos `channels` primeiros canais (iteração de potência
+    // na matriz de covariância). Eixo nulo se o bloco tem uma cor só
+    inline void principalAxis(const float pixels[16][4], int channels, float mean[4], float axis[4])
+    {
+        float cov[4][4] = {};
+        for (int c = 0; c < 4; c++) {
+            mean[c] = 0.0f;
+            axis[c] = 0.0f;
+        }
+        for (int p = 0; p < 16; p++)
+            for (int c = 0; c < channels; c++)
+                mean[c] += pixels[p][c] / 16.0f;
+        for (int p = 0; p < 16; p++)
+            for (int a = 0; a < channels; a++)
+                for (int b = 0; b < channels; b++)
+                    cov[a][b] += (pixels[p][a] - mean[a]) * (pixels[p][b] - mean[b]);
+
+        float v[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        for (int iteration = 0; iteration < 8; iteration++) {
+            float next[4] = {};
+            float length = 0.0f;
+            for (int a = 0; a < channels; a++) {
+                for (int b = 0; b < channels; b++)
+                    next[a] += cov[a][b] * v[b];
+                length = std::max(length, std::fabs(next[a]));
+            }
+            if (length < 1e-6f)
+                return;
+            for (int a = 0; a < channels; a++)
+                v[a] = next[a] / length;
+        }
+        float length = 0.0f;
+        for (int c = 0; c < channels; c++)
+            length += v[c] * v[c];
+        length = std::sqrt(length);
+        for (int c = 0; c < channels; c++)
+            axis[c] = v[c] / length;
+    }
+
+    // Pontas do segmento: extremos da projeção das cores no eixo principal
+    inline void axisEndpoints(const float pixels[16][4], int channels, float e0[4], float e1[4])
+    {
+        float mean[4], axis[4];
+        principalAxis(pixels, channels, mean, axis);
+        float tMin = 0.0f, tMax = 0.0f;
+        for (int p = 0; p < 16; p++) {
+            float t = 0.0f;
+            for (int c = 0; c < channels; c++)
+                t += (pixels[p][c] - mean[c]) * axis[c];
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+        for (int c = 0; c < 4; c++) {
+            e0[c] = std::min(255.0f, std::max(0.0f, mean[c] + tMin * axis[c]));
+            e1[c] = std::min(255.0f, std::max(0.0f, mean[c] + tMax * axis[c]));
+        }
+    }
+
+    // Extremos a e b que minimizam a soma de |(1 - w) a + w b - pixel|², com
+    // o peso w de cada pixel fixo. Falha se todos os pesos forem iguais
+    inline bool fitEndpoints(const float pixels[16][4], int channels, const float w[16], float a[4], float b[4])
+    {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float ap[4] = {}, bp[4] = {};
+        for (int p = 0; p < 16; p++) {
+            float u = 1.0f - w[p];
+            aa += u * u;
+            ab += u * w[p];
+            bb += w[p] * w[p];
+            for (int c = 0; c < channels; c++) {
+                ap[c] += u * pixels[p][c];
+                bp[c] += w[p] * pixels[p][c];
+            }
+        }
+        float det = aa * bb - ab * ab;
+        if (std::fabs(det) < 1e-6f)
+            return false;
+        for (int c = 0; c < channels; c++) {
+            a[c] = std::min(255.0f, std::max(0.0f, (ap[c] * bb - bp[c] * ab) / det));
+            b[c] = std::min(255.0f, std::max(0.0f, (bp[c] * aa - ap[c] * ab) / det));
+        }
+        return true;
+    }
+
+    // Paleta: índice do pixel com a cor mais próxima e o erro total
+    template <int N>
+    inline float pickIndices(const float pixels[16][4], int channels, const float palette[N][4], int indices[16])
+    {
+        float total = 0.0f;
+        for (int p = 0; p < 16; p++) {
+            float best = 1e30f;
+            for (int i = 0; i < N; i++) {
+                float d = 0.0f;
+                for (int c = 0; c < channels; c++) {
+                    float e = pixels[p][c] - palette[i][c];
+                    d += e * e;
+                }
+                if (d < best) {
+                    best = d;
+                    indices[p] = i;
+                }
+            }
+            total += best;
+        }
+        return total;
+    }
+
+    // Grava os bits do bloco do menos para o mais significativo
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(unsigned char* out, size_t bytes) : out(out) { std::memset(out, 0, bytes); }
+
+        void put(uint32_t value, int bits)
+        {
+            for (int b = 0; b < bits; b++, position++)
+                if (value >> b & 1)
+                    out[position >> 3] |= (unsigned char)(1 << (position & 7));
+        }
+
+    private:
+        unsigned char* out;
+        int position = 0;
+    };
+
+    inline uint16_t packColor565(const float c[4])
+    {
+        int r = (int)std::lround(c[0] * 31.0f / 255.0f);
+        int g = (int)std::lround(c[1] * 63.0f / 255.0f);
+        int b = (int)std::lround(c[2] * 31.0f / 255.0f);
+        return (uint16_t)(r << 11 | g << 5 | b);
+    }
+
+    inline void unpackColor565(uint16_t v, float c[4])
+    {
+        int r = v >> 11 & 31, g = v >> 5 & 63, b = v & 31;
+        c[0] = (float)(r << 3 | r >> 2);
+        c[1] = (float)(g << 2 | g >> 4);
+        c[2] = (float)(b << 3 | b >> 2);
+        c[3] = 255.0f;
+    }
+
+    // Bloco de cor do BC1 (e do BC3), sempre no modo de 4 cores (c0 > c1)
+    inline void encodeColorBlock(const float pixels[16][4], unsigned char out[8])
+    {
+        // Peso de c1 em cada índice: 0 = c0, 1 = c1, 2 = 2/3 c0 + 1/3 c1, 3 = 1/3 c0 + 2/3 c1
+        const float kWeight[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+        float e0[4], e1[4];
+        axisEndpoints(pixels, 3, e1, e0);
+        uint16_t bestC0 = 0, bestC1 = 0;
+        int bestIndices[16] = {};
+        float bestError = 1e30f;
+        for (int iteration = 0; iteration < 3; iteration++) {
+            uint16_t c0 = packColor565(e0), c1 = packColor565(e1);
+            float palette[4][4];
+            unpackColor565(c0, palette[0]);
+            unpackColor565(c1, palette[1]);
+            for (int i = 2; i < 4; i++)
+                for (int c = 0; c < 3; c++)
+                    palette[i][c] = palette[0][c] + (palette[1][c] - palette[0][c]) * kWeight[i];
+            int indices[16];
+            float error = pickIndices<4>(pixels, 3, palette, indices);
+            if (error < bestError) {
+                bestError = error;
+                bestC0 = c0;
+                bestC1 = c1;
+                std::memcpy(bestIndices, indices, sizeof(indices));
+            }
+            float w[16];
+            for (int p = 0; p < 16; p++)
+                w[p] = kWeight[indices[p]];
+            if (error == 0.0f || !fitEndpoints(pixels, 3, w, e0, e1))
+                break;
+        }
+
+        // c0 <= c1 seria o modo de 3 cores: troca as pontas (e os índices)
+        if (bestC0 < bestC1) {
+            std::swap(bestC0, bestC1);
+            for (int p = 0; p < 16; p++)
+                bestIndices[p] ^= 1;
+        } else if (bestC0 == bestC1) {
+            std::memset(bestIndices, 0, sizeof(bestIndices));
+        }
+        BitWriter bits(out, 8);
+        bits.put(bestC0, 16);
+        bits.put(bestC1, 16);
+        for (int p = 0; p < 16; p++)
+            bits.put(bestIndices[p], 2);
+    }
+
+    // Bloco de alfa do BC3: a0 > a1, 6 níveis interpolados entre eles
+    inline void encodeAlphaBlock(const float pixels[16][4], unsigned char out[8])
+    {
+        float lo = 255.0f, hi = 0.0f;
+        for (int p = 0; p < 16; p++) {
+            lo = std::min(lo, pixels[p][3]);
+            hi = std::max(hi, pixels[p][3]);
+        }
+        int a0 = (int)std::lround(hi), a1 = (int)std::lround(lo);
+        BitWriter bits(out, 8);
+        bits.put(a0, 8);
+        bits.put(a1, 8);
+        if (a0 == a1)
+            return;
+
+        float palette[8][4] = {};
+        palette[0][0] = (float)a0;
+        palette[1][0] = (float)a1;
+        for (int i = 2; i < 8; i++)
+            palette[i][0] = (float)(((8 - i) * a0 + (i - 1) * a1) / 7);
+        float alpha[16][4] = {};
+        for (int p = 0; p < 16; p++)
+            alpha[p][0] = pixels[p][3];
+        int indices[16];
+        pickIndices<8>(alpha, 1, palette, indices);
+        for (int p = 0; p < 16; p++)
+            bits.put(indices[p], 3);
+    }
+
+    // Ponta do BC7 modo 6: 7 bits por canal + 1 bit p comum aos 4 canais
+    inline void quantizeEndpoint7(const float e[4], int q[4], int& pBit, float value[4])
+    {
+        float bestError = 1e30f;
+        for (int p = 0; p < 2; p++) {
+            int candidate[4];
+            float error = 0.0f;
+            for (int c = 0; c < 4; c++) {
+                candidate[c] = std::min(127, std::max(0, (int)std::lround((e[c] - p) / 2.0f)));
+                float d = (float)(candidate[c] << 1 | p) - e[c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                pBit = p;
+                for (int c = 0; c < 4; c++) {
+                    q[c] = candidate[c];
+                    value[c] = (float)(candidate[c] << 1 | p);
+                }
+            }
+        }
+    }
+
+    // BC7 modo 5: cor (RGB 777, índices de 2 bits) e alfa (8 bits, índices de
+    // 2 bits) em retas separadas; melhor que o modo 6 quando o alfa não
+    // acompanha a cor (recortes, bordas de ilhas de UV). Retorna o erro
+    inline float encodeBC7Mode5(const float pixels[16][4], unsigned char out[16])
+    {
+        const int kWeights2[4] = {0, 21, 43, 64};
+
+        float e0[4], e1[4];
+        axisEndpoints(pixels, 3, e0, e1);
+        int q[2][3];
+        float v[2][3];
+        for (int c = 0; c < 3; c++) {
+            q[0][c] = (int)std::lround(e0[c] * 127.0f / 255.0f);
+            q[1][c] = (int)std::lround(e1[c] * 127.0f / 255.0f);
+            v[0][c] = (float)(q[0][c] << 1 | q[0][c] >> 6);
+            v[1][c] = (float)(q[1][c] << 1 | q[1][c] >> 6);
+        }
+        float palette[4][4];
+        for (int i = 0; i < 4; i++)
+            for (int c = 0; c < 3; c++)
+                palette[i][c] = (float)((int)((64 - kWeights2[i]) * v[0][c] + kWeights2[i] * v[1][c] + 32) >> 6);
+        int colorIndices[16];
+        float error = pickIndices<4>(pixels, 3, palette, colorIndices);
+
+        float lo = 255.0f, hi = 0.0f;
+        float alpha[16][4] = {};
+        for (int p = 0; p < 16; p++) {
+            alpha[p][0] = pixels[p][3];
+            lo = std::min(lo, pixels[p][3]);
+            hi = std::max(hi, pixels[p][3]);
+        }
+        int a[2] = {(int)std::lround(lo), (int)std::lround(hi)};
+        float alphaPalette[4][4] = {};
+        for (int i = 0; i < 4; i++)
+            alphaPalette[i][0] = (float)(((64 - kWeights2[i]) * a[0] + kWeights2[i] * a[1] + 32) >> 6);
+        int alphaIndices[16];
+        error += pickIndices<4>(alpha, 1, alphaPalette, alphaIndices);
+
+        // Como no modo 6, o índice do pixel 0 perde o bit mais alto (em cada reta)
+        if (colorIndices[0] >= 2) {
+            std::swap(q[0], q[1]);
+            for (int p = 0; p < 16; p++)
+                colorIndices[p] = 3 - colorIndices[p];
+        }
+        if (alphaIndices[0] >= 2) {
+            std::swap(a[0], a[1]);
+            for (int p = 0; p < 16; p++)
+                alphaIndices[p] = 3 - alphaIndices[p];
+        }
+        BitWriter bits(out, 16);
+        bits.put(1 << 5, 6);
+        bits.put(0, 2);         // sem rotação de canais
+        for (int c = 0; c < 3; c++) {
+            bits.put(q[0][c], 7);
+            bits.put(q[1][c], 7);
+        }
+        bits.put(a[0], 8);
+        bits.put(a[1], 8);
+        for (int p = 0; p < 16; p++)
+            bits.put(colorIndices[p], p == 0 ? 1 : 2);
+        for (int p = 0; p < 16; p++)
+            bits.put(alphaIndices[p], p == 0 ? 1 : 2);
+        return error;
+    }
+
+    // BC7 modo 6: um subconjunto, RGBA 7777 + bit p, índices de 4 bits; se o
+    // alfa varia no bloco, testa também o modo 5 e fica com o menor erro
+    inline void encodeBC7Block(const float pixels[16][4], unsigned char out[16])
+    {
+        float e0[4], e1[4];
+        axisEndpoints(pixels, 4, e0, e1);
+        int bestQ[2][4] = {}, bestP[2] = {}, bestIndices[16] = {};
+        float bestError = 1e30f;
+        for (int iteration = 0; iteration < 3; iteration++) {
+            int q[2][4], pBit[2];
+            float v[2][4];
+            quantizeEndpoint7(e0, q[0], pBit[0], v[0]);
+            quantizeEndpoint7(e1, q[1], pBit[1], v[1]);
+            float palette[16][4];
+            for (int i = 0; i < 16; i++)
+                for (int c = 0; c < 4; c++)
+                    palette[i][c] = (float)((int)((64 - kWeights4[i]) * v[0][c] + kWeights4[i] * v[1][c] + 32) >> 6);
+            int indices[16];
+            float error = pickIndices<16>(pixels, 4, palette, indices);
+            if (error < bestError) {
+                bestError = error;
+                std::memcpy(bestQ, q, sizeof(q));
+                std::memcpy(bestP, pBit, sizeof(pBit));
+                std::memcpy(bestIndices, indices, sizeof(indices));
+            }
+            float w[16];
+            for (int p = 0; p < 16; p++)
+                w[p] = kWeights4[indices[p]] / 64.0f;
+            if (error == 0.0f || !fitEndpoints(pixels, 4, w, e0, e1))
+                break;
+        }
+
+        // O índice do pixel 0 é gravado sem o bit mais alto: tem que ser < 8
+        if (bestIndices[0] >= 8) {
+            for (int c = 0; c < 4; c++)
+                std::swap(bestQ[0][c], bestQ[1][c]);
+            std::swap(bestP[0], bestP[1]);
+            for (int p = 0; p < 16; p++)
+                bestIndices[p] = 15 - bestIndices[p];
+        }
+        bool alphaVaries = false;
+        for (int p = 1; p < 16; p++)
+            alphaVaries = alphaVaries || pixels[p][3] != pixels[0][3];
+        if (alphaVaries) {
+            unsigned char mode5[16];
+            if (encodeBC7Mode5(pixels, mode5) < bestError) {
+                std::memcpy(out, mode5, 16);
+                return;
+            }
+        }
+
+        BitWriter bits(out, 16);
+        bits.put(1 << 6, 7);
+        for (int c = 0; c < 4; c++) {
+            bits.put(bestQ[0][c], 7);
+            bits.put(bestQ[1][c], 7);
+        }
+        bits.put(bestP[0], 1);
+        bits.put(bestP[1], 1);
+        bits.put(bestIndices[0], 3);
+        for (int p = 1; p < 16; p++)
+            bits.put(bestIndices[p], 4);
+    }
+
+    inline void encodeBlock(TextureCompression format, const float pixels[16][4], unsigned char* out)
+    {
+        switch (format) {
+        case TextureCompression::BC1:
+            encodeColorBlock(pixels, out);
+            break;
+        case TextureCompression::BC3:
+            encodeAlphaBlock(pixels, out);
+            encodeColorBlock(pixels, out + 8);
+            break;
+        case TextureCompression::BC7:
+            encodeBC7Block(pixels, out);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Próximo nível da cadeia: média de 2x2 pixels (a última linha/coluna se repete
+    // nos tamanhos ímpares)
+    inline void downsample(const std::vector<unsigned char>& src, int width, int height, std::vector<unsigned char>& dst)
+    {
+        int w = std::max(1, width >> 1), h = std::max(1, height >> 1);
+        dst.resize((size_t)w * h * 4);
+        for (int y = 0; y < h; y++) {
+            int y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+            for (int x = 0; x < w; x++) {
+                int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+                for (int c = 0; c < 4; c++) {
+                    int sum = src[((size_t)y0 * width + x0) * 4 + c] + src[((size_t)y0 * width + x1) * 4 + c] +
+                              src[((size_t)y1 * width + x0) * 4 + c] + src[((size_t)y1 * width + x1) * 4 + c];
+                    dst[((size_t)y * w + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+        }
+    }
+}
+
+// Comprime a imagem RGBA8 (linhas em sequência) em `format`; com mipmaps, a
+// cadeia inteira até 1x1. As linhas de blocos são divididas entre `threads`
+inline void compressTexture(const unsigned char* rgba, int width, int height, TextureCompression format, bool mipmaps,
+                            CompressedImage& image, int threads = 1)
+{
+    image.format = format;
+    image.width = width;
+    image.height = height;
+    image.levels = 1;
+    if (mipmaps)
+        for (int size = std::max(width, height); size > 1; size >>= 1)
+            image.levels++;
+    image.data.assign(image.levelOffset(image.levels), 0);
+
+    std::vector<unsigned char> level(rgba, rgba + (size_t)width * height * 4), next;
+    for (int l = 0; l < image.levels; l++) {
+        int w = image.levelWidth(l), h = image.levelHeight(l);
+        int blocksX = (w + 3) / 4, blocksY = (h + 3) / 4;
+        unsigned char* out = image.data.data() + image.levelOffset(l);
+        size_t blockBytes = compressedBlockBytes(format);
+        const unsigned char* src = level.data();
+        parallelFor(blocksY, blocksY >= 16 ? threads : 1, [&](int by) {
+            float pixels[16][4];
+            for (int bx = 0; bx < blocksX; bx++) {
+                bcn::fetchBlock(src, w, h, bx * 4, by * 4, pixels);
+                bcn::encodeBlock(format, pixels, out + ((size_t)by * blocksX + bx) * blockBytes);
+            }
+        });
+        if (l + 1 < image.levels) {
+            bcn::downsample(level, w, h, next);
+            level.swap(next);
+        }
+    }
+}
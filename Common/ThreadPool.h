@@ -0,0 +1,121 @@
+/*
+ *  Paralelismo simples para as rotinas de carga (leitura de .obj etc.).
+ *
+ *  parallelFor(count, threads, fn) executa fn(0) ... fn(count - 1) usando até
+ *  `threads` threads (0 = número de núcleos). As threads pegam a próxima tarefa
+ *  livre de um contador atômico, então tarefas de tamanhos diferentes ficam
+ *  bem distribuídas. Retorna só depois que todas as tarefas terminarem.
+ *
+ *  WorkerPool mantém threads vivas para tarefas que chegam aos poucos (carga
+ *  de assets em segundo plano, AssetLoader.h): submit() só enfileira e volta.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+inline int resolveThreadCount(int threads)
+{
+    if (threads > 0)
+        return threads;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? (int)hw : 1;
+}
+
+inline void parallelFor(int count, int threads, const std::function<void(int)>& fn)
+{
+    threads = std::min(resolveThreadCount(threads), count);
+    if (threads <= 1) {
+        for (int i = 0; i < count; i++)
+            fn(i);
+        return;
+    }
+
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        for (int i = next++; i < count; i = next++)
+            fn(i);
+    };
+
+    // A thread atual também trabalha
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool)
+        t.join();
+}
+
+class WorkerPool
+{
+public:
+    explicit WorkerPool(int threads = 0)
+    {
+        threads = resolveThreadCount(threads);
+        for (int t = 0; t < threads; t++)
+            pool.emplace_back([this]() { run(); });
+    }
+
+    ~WorkerPool() { stop(); }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping)
+                return;
+            tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+    // Descarta as tarefas que ainda não começaram e espera as que estão rodando
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            tasks.clear();
+        }
+        wake.notify_all();
+        for (std::thread& t : pool)
+            if (t.joinable())
+                t.join();
+        pool.clear();
+    }
+
+    int size() const { return (int)pool.size(); }
+
+private:
+    void run()
+    {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (stopping)
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> pool;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
@@ -0,0 +1,447 @@
+/*
+ *  Formatos de vértice: descrição dos atributos de um VBO intercalado
+ *  (VertexLayout) e versões compactadas dos atributos usados nos exercícios.
+ *
+ *  Os exercícios montam os vértices em floats (x, y, z, r, g, b = 24 bytes).
+ *  Com um VertexFormat compactado, packVertices converte para:
+ *   - posição: half float ou 16 bits normalizado (snorm16), 4 componentes
+ *     (8 bytes, w = 1) para manter o alinhamento de 4 bytes;
+ *   - cor: RGBA8 normalizado (4 bytes);
+ *   - normal: octaedro em 2 x snorm16 (4 bytes; decodificar no shader com
+ *     kOctahedralDecodeGLSL);
+ *   - coord. de textura: 2 x half float (4 bytes).
+ *  Posição + cor passam de 24 para 12 bytes; com normal e coord. de textura,
+ *  de 44 para 20 bytes.
+ *
+ *  Posições snorm16 só representam [-1, 1]. Se a geometria sai desse
+ *  intervalo (malhas .obj), as posições são guardadas relativas à caixa
+ *  envolvente e packVertices devolve a transformação (PositionQuantization)
+ *  que o shader precisa aplicar, normalmente junto da matriz de modelo.
+ *
+ *  Locations usadas: 0 = posição, 1 = cor, 2 = coord. de textura, 3 = normal.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+// Um atributo de um VBO intercalado (parâmetros do glVertexAttribPointer)
+struct VertexAttribute
+{
+    GLuint location;
+    GLint components;
+    GLenum type;
+    GLboolean normalized;
+    GLuint offset;      // em bytes, a partir do início do vértice
+};
+
+struct VertexLayout
+{
+    static const int kMaxAttributes = 8;
+
+    GLsizei stride = 0;  // bytes por vértice
+    int count = 0;
+    VertexAttribute attributes[kMaxAttributes];
+
+    void add(GLuint location, GLint components, GLenum type, GLboolean normalized, GLuint offset)
+    {
+        if (count < kMaxAttributes)
+            attributes[count++] = {location, components, type, normalized, offset};
+    }
+};
+
+// Bytes ocupados por um atributo em um vértice
+inline GLuint vertexAttributeBytes(const VertexAttribute& a)
+{
+    GLuint typeBytes = 4;
+    if (a.type == GL_HALF_FLOAT || a.type == GL_SHORT || a.type == GL_UNSIGNED_SHORT)
+        typeBytes = 2;
+    else if (a.type == GL_BYTE || a.type == GL_UNSIGNED_BYTE)
+        typeBytes = 1;
+    return a.components * typeBytes;
+}
+
+// Como os atributos ficam nos VBOs: intercalados num VBO só (AoS) ou um VBO
+// por atributo (SoA). SoA ajuda passadas que só leem a posição (profundidade):
+// os caches da GPU não trazem cor/normal/coord. de textura junto
+enum class VertexStreams : uint8_t { Interleaved, Separate };
+
+// Registra os atributos no VAO ativo (o VBO precisa estar ligado em GL_ARRAY_BUFFER)
+inline void applyVertexLayout(const VertexLayout& layout)
+{
+    for (int i = 0; i < layout.count; i++) {
+        const VertexAttribute& a = layout.attributes[i];
+        glVertexAttribPointer(a.location, a.components, a.type, a.normalized, layout.stride,
+                              (GLvoid*)(size_t)a.offset);
+        glEnableVertexAttribArray(a.location);
+    }
+}
+
+const GLuint kPositionLocation = 0;
+const GLuint kColorLocation = 1;
+const GLuint kTexCoordLocation = 2;
+const GLuint kNormalLocation = 3;
+
+enum class PositionFormat : uint8_t { Float3, Half4, Snorm16x4 };
+enum class ColorFormat : uint8_t { Float3, RGBA8 };
+enum class TexCoordFormat : uint8_t { None, Float2, Half2 };
+enum class NormalFormat : uint8_t { None, Float3, Oct16 };
+
+struct VertexFormat
+{
+    PositionFormat position = PositionFormat::Float3;
+    ColorFormat color = ColorFormat::Float3;
+    TexCoordFormat texCoord = TexCoordFormat::None;
+    NormalFormat normal = NormalFormat::None;
+
+    // Identificador único do formato (gravado no cache de malhas)
+    uint32_t key() const
+    {
+        return (uint32_t)position | (uint32_t)color << 8 | (uint32_t)texCoord << 16 | (uint32_t)normal << 24;
+    }
+
+    bool operator==(const VertexFormat& o) const { return key() == o.key(); }
+};
+
+// Formato dos exercícios: x, y, z, r, g, b em floats
+inline VertexFormat floatVertexFormat()
+{
+    return VertexFormat();
+}
+
+// Versão compactada (12 bytes por vértice)
+inline VertexFormat packedVertexFormat()
+{
+    VertexFormat format;
+    format.position = PositionFormat::Snorm16x4;
+    format.color = ColorFormat::RGBA8;
+    return format;
+}
+
+// Onde estão os atributos num buffer de floats: deslocamentos em floats
+// dentro de cada vértice (-1 = atributo ausente)
+struct FloatVertexSource
+{
+    const GLfloat* data = NULL;
+    size_t count = 0;           // vértices
+    size_t stride = 6;          // floats por vértice
+    int position = 0;
+    int color = 3;
+    int texCoord = -1;
+    int normal = -1;
+};
+
+// Posição real = offset + scale * posição armazenada
+struct PositionQuantization
+{
+    glm::vec3 offset = glm::vec3(0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+
+    bool identity() const
+    {
+        return offset.x == 0.0f && offset.y == 0.0f && offset.z == 0.0f &&
+               scale.x == 1.0f && scale.y == 1.0f && scale.z == 1.0f;
+    }
+};
+
+namespace vertexpack
+{
+    // float -> half (IEEE 754 binário16), arredondando para o par mais próximo
+    inline uint16_t floatToHalf(float value)
+    {
+        uint32_t f;
+        std::memcpy(&f, &value, 4);
+        uint32_t sign = (f >> 16) & 0x8000u;
+        uint32_t absf = f & 0x7FFFFFFFu;
+
+        if (absf >= 0x7F800000u)                       // inf / NaN
+            return (uint16_t)(sign | 0x7C00u | (absf > 0x7F800000u ? 0x200u : 0u));
+        if (absf >= 0x477FF000u)                       // grande demais: inf
+            return (uint16_t)(sign | 0x7C00u);
+        if (absf < 0x38800000u) {                      // subnormal ou zero
+            if (absf < 0x33000000u)
+                return (uint16_t)sign;
+            uint32_t mant = (absf & 0x007FFFFFu) | 0x00800000u;
+            int shift = 126 - (int)(absf >> 23);       // 14..24
+            uint32_t half = mant >> shift;
+            uint32_t rest = mant & ((1u << shift) - 1);
+            uint32_t mid = 1u << (shift - 1);
+            if (rest > mid || (rest == mid && (half & 1u)))
+                half++;
+            return (uint16_t)(sign | half);
+        }
+
+        uint32_t half = ((absf >> 13) - (112u << 10));
+        uint32_t rest = absf & 0x1FFFu;
+        if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+            half++;
+        return (uint16_t)(sign | half);
+    }
+
+    inline float halfToFloat(uint16_t h)
+    {
+        uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+        uint32_t exp = (h >> 10) & 0x1Fu;
+        uint32_t mant = h & 0x3FFu;
+        uint32_t f;
+        if (exp == 0) {
+            if (mant == 0) {
+                f = sign;
+            } else {                                   // subnormal: normaliza
+                exp = 113;
+                while (!(mant & 0x400u)) {
+                    mant <<= 1;
+                    exp--;
+                }
+                f = sign | (exp << 23) | ((mant & 0x3FFu) << 13);
+            }
+        } else if (exp == 31) {
+            f = sign | 0x7F800000u | (mant << 13);
+        } else {
+            f = sign | ((exp + 112) << 23) | (mant << 13);
+        }
+        float value;
+        std::memcpy(&value, &f, 4);
+        return value;
+    }
+
+    // Mesma conversão que a GPU desfaz com normalized = GL_TRUE
+    inline int16_t packSnorm16(float v)
+    {
+        return (int16_t)std::lround(std::min(std::max(v, -1.0f), 1.0f) * 32767.0f);
+    }
+
+    inline uint8_t packUnorm8(float v)
+    {
+        return (uint8_t)std::lround(std::min(std::max(v, 0.0f), 1.0f) * 255.0f);
+    }
+
+    // Cor em [0, 1] -> RGBA8 num uint32_t (r no byte menos significativo)
+    inline uint32_t packRGBA8(glm::vec4 color)
+    {
+        return (uint32_t)packUnorm8(color.r) | (uint32_t)packUnorm8(color.g) << 8 |
+               (uint32_t)packUnorm8(color.b) << 16 | (uint32_t)packUnorm8(color.a) << 24;
+    }
+
+    // Normal unitária -> ponto no octaedro desdobrado em [-1, 1]^2
+    inline glm::vec2 octahedralEncode(glm::vec3 n)
+    {
+        float l1 = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+        if (l1 == 0.0f)
+            return glm::vec2(0.0f, 0.0f);
+        glm::vec2 p(n.x / l1, n.y / l1);
+        if (n.z < 0.0f) {
+            glm::vec2 folded((1.0f - std::fabs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                             (1.0f - std::fabs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+            p = folded;
+        }
+        return p;
+    }
+
+    inline glm::vec3 octahedralDecode(glm::vec2 e)
+    {
+        glm::vec3 v(e.x, e.y, 1.0f - std::fabs(e.x) - std::fabs(e.y));
+        if (v.z < 0.0f) {
+            float x = (1.0f - std::fabs(v.y)) * (v.x >= 0.0f ? 1.0f : -1.0f);
+            float y = (1.0f - std::fabs(v.x)) * (v.y >= 0.0f ? 1.0f : -1.0f);
+            v.x = x;
+            v.y = y;
+        }
+        return glm::normalize(v);
+    }
+
+    inline void put(unsigned char*& out, const void* data, size_t bytes)
+    {
+        std::memcpy(out, data, bytes);
+        out += bytes;
+    }
+}
+
+// Decodificação da normal Oct16 no vertex shader:
+//   layout (location = 3) in vec2 aNormalOct;
+//   vec3 normal = octDecode(aNormalOct);
+const char* const kOctahedralDecodeGLSL =
+    "vec3 octDecode(vec2 e)\n"
+    "{\n"
+    "    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n"
+    "    if (v.z < 0.0)\n"
+    "        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);\n"
+    "    return normalize(v);\n"
+    "}\n";
+
+inline VertexLayout makeVertexLayout(const VertexFormat& format)
+{
+    VertexLayout layout;
+    GLuint offset = 0;
+
+    switch (format.position) {
+    case PositionFormat::Float3:
+        layout.add(kPositionLocation, 3, GL_FLOAT, GL_FALSE, offset);
+        offset += 3 * sizeof(GLfloat);
+        break;
+    case PositionFormat::Half4:
+        layout.add(kPositionLocation, 4, GL_HALF_FLOAT, GL_FALSE, offset);
+        offset += 4 * sizeof(uint16_t);
+        break;
+    case PositionFormat::Snorm16x4:
+        layout.add(kPositionLocation, 4, GL_SHORT, GL_TRUE, offset);
+        offset += 4 * sizeof(int16_t);
+        break;
+    }
+
+    if (format.color == ColorFormat::Float3) {
+        layout.add(kColorLocation, 3, GL_FLOAT, GL_FALSE, offset);
+        offset += 3 * sizeof(GLfloat);
+    } else {
+        layout.add(kColorLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, offset);
+        offset += 4;
+    }
+
+    if (format.texCoord == TexCoordFormat::Float2) {
+        layout.add(kTexCoordLocation, 2, GL_FLOAT, GL_FALSE, offset);
+        offset += 2 * sizeof(GLfloat);
+    } else if (format.texCoord == TexCoordFormat::Half2) {
+        layout.add(kTexCoordLocation, 2, GL_HALF_FLOAT, GL_FALSE, offset);
+        offset += 2 * sizeof(uint16_t);
+    }
+
+    if (format.normal == NormalFormat::Float3) {
+        layout.add(kNormalLocation, 3, GL_FLOAT, GL_FALSE, offset);
+        offset += 3 * sizeof(GLfloat);
+    } else if (format.normal == NormalFormat::Oct16) {
+        layout.add(kNormalLocation, 2, GL_SHORT, GL_TRUE, offset);
+        offset += 2 * sizeof(int16_t);
+    }
+
+    layout.stride = offset;
+    return layout;
+}
+
+// Converte os vértices de `source` para `format` (bytes prontos para o VBO).
+// Atributos pedidos pelo formato mas ausentes na origem saem zerados
+inline PositionQuantization packVertices(const VertexFormat& format, const FloatVertexSource& source,
+                                         std::vector<unsigned char>& out)
+{
+    using namespace vertexpack;
+
+    PositionQuantization quant;
+    if (format.position == PositionFormat::Snorm16x4 && source.count > 0) {
+        glm::vec3 bmin(source.data[source.position], source.data[source.position + 1], source.data[source.position + 2]);
+        glm::vec3 bmax = bmin;
+        for (size_t i = 0; i < source.count; i++) {
+            const GLfloat* p = source.data + i * source.stride + source.position;
+            bmin = glm::min(bmin, glm::vec3(p[0], p[1], p[2]));
+            bmax = glm::max(bmax, glm::vec3(p[0], p[1], p[2]));
+        }
+        // Dentro de [-1, 1] (formas 2D em coordenadas normalizadas): guarda
+        // direto, sem transformação extra no shader
+        bool fits = bmin.x >= -1.0f && bmin.y >= -1.0f && bmin.z >= -1.0f &&
+                    bmax.x <= 1.0f && bmax.y <= 1.0f && bmax.z <= 1.0f;
+        if (!fits) {
+            quant.offset = (bmin + bmax) * 0.5f;
+            quant.scale = (bmax - bmin) * 0.5f;
+            for (int k = 0; k < 3; k++)
+                if (quant.scale[k] == 0.0f)
+                    quant.scale[k] = 1.0f;
+        }
+    }
+
+    VertexLayout layout = makeVertexLayout(format);
+    out.resize(source.count * layout.stride);
+    unsigned char* dst = out.data();
+
+    for (size_t i = 0; i < source.count; i++) {
+        const GLfloat* v = source.data + i * source.stride;
+        glm::vec3 pos(v[source.position], v[source.position + 1], v[source.position + 2]);
+
+        switch (format.position) {
+        case PositionFormat::Float3:
+            put(dst, &pos.x, 3 * sizeof(GLfloat));
+            break;
+        case PositionFormat::Half4: {
+            uint16_t h[4] = {floatToHalf(pos.x), floatToHalf(pos.y), floatToHalf(pos.z), floatToHalf(1.0f)};
+            put(dst, h, sizeof(h));
+            break;
+        }
+        case PositionFormat::Snorm16x4: {
+            int16_t s[4];
+            for (int k = 0; k < 3; k++)
+                s[k] = packSnorm16((pos[k] - quant.offset[k]) / quant.scale[k]);
+            s[3] = 32767;
+            put(dst, s, sizeof(s));
+            break;
+        }
+        }
+
+        glm::vec3 color(0.0f);
+        if (source.color >= 0)
+            color = glm::vec3(v[source.color], v[source.color + 1], v[source.color + 2]);
+        if (format.color == ColorFormat::Float3) {
+            put(dst, &color.x, 3 * sizeof(GLfloat));
+        } else {
+            uint8_t c[4] = {packUnorm8(color.r), packUnorm8(color.g), packUnorm8(color.b), 255};
+            put(dst, c, sizeof(c));
+        }
+
+        glm::vec2 uv(0.0f);
+        if (source.texCoord >= 0)
+            uv = glm::vec2(v[source.texCoord], v[source.texCoord + 1]);
+        if (format.texCoord == TexCoordFormat::Float2) {
+            put(dst, &uv.x, 2 * sizeof(GLfloat));
+        } else if (format.texCoord == TexCoordFormat::Half2) {
+            uint16_t h[2] = {floatToHalf(uv.x), floatToHalf(uv.y)};
+            put(dst, h, sizeof(h));
+        }
+
+        glm::vec3 n(0.0f);
+        if (source.normal >= 0)
+            n = glm::vec3(v[source.normal], v[source.normal + 1], v[source.normal + 2]);
+        if (format.normal == NormalFormat::Float3) {
+            put(dst, &n.x, 3 * sizeof(GLfloat));
+        } else if (format.normal == NormalFormat::Oct16) {
+            glm::vec2 e = octahedralEncode(n);
+            int16_t s[2] = {packSnorm16(e.x), packSnorm16(e.y)};
+            put(dst, s, sizeof(s));
+        }
+    }
+
+    return quant;
+}
+
+// Envia vértices x, y, z, r, g, b (floats, como os exercícios montam) para o
+// GL_ARRAY_BUFFER ligado e registra os atributos no VAO ligado. Com `packed`,
+// usa o formato compactado; se alguma posição sair de [-1, 1], a posição fica
+// em half float para o shader continuar sem transformação extra.
+// Retorna o número de bytes enviados
+inline size_t uploadShapeVertices(const float* vertices, size_t floatCount, bool packed, GLenum usage = GL_STATIC_DRAW)
+{
+    FloatVertexSource source;
+    source.data = vertices;
+    source.count = floatCount / 6;
+
+    VertexFormat format = packed ? packedVertexFormat() : floatVertexFormat();
+    std::vector<unsigned char> bytes;
+    if (!packVertices(format, source, bytes).identity()) {
+        format.position = PositionFormat::Half4;
+        packVertices(format, source, bytes);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, bytes.size(), bytes.data(), usage);
+    applyVertexLayout(makeVertexLayout(format));
+    return bytes.size();
+}
+
+inline size_t uploadShapeVertices(const std::vector<float>& vertices, bool packed, GLenum usage = GL_STATIC_DRAW)
+{
+    return uploadShapeVertices(vertices.data(), vertices.size(), packed, usage);
+}
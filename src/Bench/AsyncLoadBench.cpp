@@ -0,0 +1,373 @@
+/*
+ *  Benchmark da carga em segundo plano (Common/AssetLoader.h): mede quanto
+ *  tempo a janela leva para mostrar o primeiro frame e quanto cada frame
+ *  demora enquanto os modelos ainda estão sendo lidos e enviados à GPU.
+ *
+ *  Uso: asyncloadbench [--models M] [--tris N] [--obj arquivo] [--workers W]
+ *                      [--sync] [--cache] [--stream] [--batch-mb B] [--frame-ms F] [--dir pasta] [--keep]
+ *                      [opções do RunMode.h]
+ *    --models M  quantos .obj gerar (padrão: 4), cada um com ~N triângulos
+ *                (--tris, padrão: 500000)
+ *    --obj       carrega também um .obj existente (pode repetir)
+ *    --workers   threads de decode do AssetLoader (padrão: núcleos - 1)
+ *    --sync      carrega tudo com loadIndexedOBJ antes do loop (como os
+ *                exercícios fazem hoje), para comparar
+ *    --cache     usa o cache binário (MeshCache.h); sem ele o .obj é sempre lido
+ *    --stream    carga progressiva (ObjStream.h): um lote de --batch-mb MB de
+ *                texto (padrão: 16) por modelo a cada frame, desenhando o que
+ *                já chegou; mostra também o pico de memória da CPU
+ *    --frame-ms  duração mínima de cada frame (padrão: 16.6 no headless, como
+ *                um vsync de 60 Hz; 0 = sem limite). Sem limite, o loop headless
+ *                ocupa a CPU inteira e, com poucos núcleos, atrasa os workers
+ *    --dir       onde gravar os .obj gerados (padrão: pasta atual)
+ *    --keep      não apaga os arquivos gerados
+ *  Ex.: asyncloadbench --headless --frames 300 --models 4 --tris 1000000
+ *
+ *  Cada modelo é desenhado numa célula da tela assim que fica pronto. O loop
+ *  roda até --frames (headless) ou até a janela fechar, e ao fim mostra o
+ *  tempo até o primeiro frame, quando cada modelo ficou pronto e o pior frame
+ *  durante a carga.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+#include "AssetLoader.h"
+#include "ObjLoader.h"
+#include "ObjStream.h"
+#include "RunMode.h"
+
+const char* vertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"layout (location = 1) in vec3 aColor;\n"
+"uniform vec4 uOffsetScale;\n"
+"out vec3 ourColor;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos.xz * uOffsetScale.w + uOffsetScale.xy, 0.0, 1.0);\n"
+"   ourColor = aColor * (0.6 + 4.0 * aPos.y);\n"
+"}\0";
+
+const char* fragmentShaderSource = "#version 460 core\n"
+"in vec3 ourColor;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = vec4(ourColor, 1.0);\n"
+"}\0";
+
+typedef std::chrono::steady_clock Clock;
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+// Grade ondulada com ~targetTris triângulos (mesmo formato do objloaderbench)
+bool generateGridOBJ(const string& path, long long targetTris, float phase)
+{
+    int n = std::max(1, (int)std::ceil(std::sqrt(targetTris / 2.0)));
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+
+    std::fprintf(f, "# grade %dx%d gerada pelo asyncloadbench\n", n, n);
+    for (int j = 0; j <= n; j++) {
+        for (int i = 0; i <= n; i++) {
+            float x = (float)i / n * 2.0f - 1.0f;
+            float z = (float)j / n * 2.0f - 1.0f;
+            float y = 0.1f * std::sin(x * 6.0f + phase) * std::cos(z * 6.0f);
+            std::fprintf(f, "v %.6f %.6f %.6f\n", x, y, z);
+        }
+    }
+    for (int j = 0; j < n; j++) {
+        for (int i = 0; i < n; i++) {
+            int a = j * (n + 1) + i + 1, b = a + 1, c = a + (n + 1), d = c + 1;
+            std::fprintf(f, "f %d %d %d\nf %d %d %d\n", a, c, b, b, c, d);
+        }
+    }
+    std::fclose(f);
+    return true;
+}
+
+GLuint compileProgram()
+{
+    int success;
+    char infoLog[512];
+    GLuint shaders[2] = {glCreateShader(GL_VERTEX_SHADER), glCreateShader(GL_FRAGMENT_SHADER)};
+    const char* sources[2] = {vertexShaderSource, fragmentShaderSource};
+    GLuint program = glCreateProgram();
+    for (int i = 0; i < 2; i++) {
+        glShaderSource(shaders[i], 1, &sources[i], NULL);
+        glCompileShader(shaders[i]);
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shaders[i], 512, NULL, infoLog);
+            std::cout << "ERRO::SHADER::COMPILACAO_FALHOU\n" << infoLog << std::endl;
+        }
+        glAttachShader(program, shaders[i]);
+    }
+    glLinkProgram(program);
+    glDeleteShader(shaders[0]);
+    glDeleteShader(shaders[1]);
+    return program;
+}
+
+int main(int argc, char** argv) {
+    Clock::time_point programStart = Clock::now();
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+
+    int models = 4;
+    long long tris = 500000;
+    int workers = 0;
+    double frameMs = run.headless ? 16.6 : 0.0;
+    size_t batchMB = 16;
+    bool sync = false, useCache = false, stream = false, keep = false;
+    string dir = ".";
+    std::vector<string> objFiles;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--models" && hasValue)
+            models = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--tris" && hasValue)
+            tris = std::atoll(argv[++i]);
+        else if (arg == "--obj" && hasValue)
+            objFiles.push_back(argv[++i]);
+        else if (arg == "--workers" && hasValue)
+            workers = std::atoi(argv[++i]);
+        else if (arg == "--frame-ms" && hasValue)
+            frameMs = std::atof(argv[++i]);
+        else if (arg == "--dir" && hasValue)
+            dir = argv[++i];
+        else if (arg == "--sync")
+            sync = true;
+        else if (arg == "--cache")
+            useCache = true;
+        else if (arg == "--stream")
+            stream = true;
+        else if (arg == "--batch-mb" && hasValue)
+            batchMB = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--keep")
+            keep = true;
+    }
+
+    // Os arquivos são gerados antes de medir (não fazem parte da carga)
+    std::vector<string> paths(objFiles);
+    for (int m = 0; m < models; m++) {
+        string path = dir + "/async_" + std::to_string(m) + ".obj";
+        if (!generateGridOBJ(path, tris, (float)m)) {
+            std::cerr << "Erro ao gerar " << path << std::endl;
+            return -1;
+        }
+        paths.push_back(path);
+    }
+    programStart = Clock::now();
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "Carga em segundo plano");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    GLuint shaderProgram = compileProgram();
+    GLint offsetScaleLoc = glGetUniformLocation(shaderProgram, "uOffsetScale");
+
+    // Com --sync tudo é carregado aqui, antes do primeiro frame
+    AssetLoader loader;
+    std::vector<std::shared_ptr<AsyncMesh>> meshes;
+    std::vector<std::unique_ptr<ObjStream>> streams;
+    for (const string& path : paths) {
+        if (stream) {
+            std::shared_ptr<AsyncMesh> asset = std::make_shared<AsyncMesh>();
+            asset->path = path;
+            streams.emplace_back(new ObjStream());
+            if (!streams.back()->open(path, batchMB * 1024 * 1024))
+                asset->state = AssetState::Failed;
+            meshes.push_back(asset);
+        } else if (sync) {
+            std::shared_ptr<AsyncMesh> asset = std::make_shared<AsyncMesh>();
+            asset->path = path;
+            Clock::time_point start = Clock::now();
+            bool ok = useCache ? loadCachedOBJ(path, asset->mesh) : loadIndexedOBJ(path, asset->mesh);
+            asset->state = ok ? AssetState::Ready : AssetState::Failed;
+            asset->readyMs = msSince(start);
+            meshes.push_back(asset);
+        } else {
+            if (meshes.empty())
+                loader.start(run, window, workers);
+            meshes.push_back(loader.loadMesh(path, ObjLoadOptions(), useCache));
+        }
+    }
+    if (!sync && !stream)
+        std::cout << "AssetLoader: " << (loader.sharedContext() ? "contexto compartilhado" : "upload na thread principal")
+                  << std::endl;
+
+    int columns = std::max(1, (int)std::ceil(std::sqrt((double)meshes.size())));
+    double firstFrameMs = -1.0, allReadyMs = -1.0, worstLoadingFrameMs = 0.0;
+    int loadingFrames = 0;
+    std::vector<double> readyAt(meshes.size(), -1.0), visibleAt(meshes.size(), -1.0);
+    if (sync)
+        allReadyMs = msSince(programStart);
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        Clock::time_point frameStart = Clock::now();
+        bool loading = allReadyMs < 0.0;
+
+        // Processa entrada
+        processInput(window);
+        loader.poll();
+
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+        glClear(GL_COLOR_BUFFER_BIT);
+        glUseProgram(shaderProgram);
+
+        // Com --stream, cada modelo ainda incompleto lê e envia mais um lote
+        for (size_t m = 0; m < streams.size(); m++) {
+            if (meshes[m]->failed() || meshes[m]->ready())
+                continue;
+            if (!streams[m]->step()) {
+                streams[m]->close();
+                meshes[m]->mesh = streams[m]->mesh();
+                meshes[m]->readyMs = msSince(programStart);
+                meshes[m]->state = AssetState::Ready;
+            }
+        }
+
+        // Cada modelo pronto (ou a parte que já chegou) é desenhado na sua célula
+        bool allDone = true;
+        for (size_t m = 0; m < meshes.size(); m++) {
+            const Mesh* mesh = &meshes[m]->mesh;
+            if (!meshes[m]->ready()) {
+                allDone = allDone && meshes[m]->failed();
+                if (streams.empty() || meshes[m]->failed() || streams[m]->mesh().nVertices == 0)
+                    continue;
+                mesh = &streams[m]->mesh();
+            } else if (readyAt[m] < 0.0) {
+                readyAt[m] = msSince(programStart);
+            }
+            if (visibleAt[m] < 0.0)
+                visibleAt[m] = msSince(programStart);
+            float cell = 2.0f / columns;
+            float x = -1.0f + cell * (m % columns + 0.5f);
+            float y = 1.0f - cell * (m / columns + 0.5f);
+            glUniform4f(offsetScaleLoc, x, y, 0.0f, cell * 0.45f);
+            drawMesh(*mesh);
+        }
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+        double elapsed = msSince(frameStart);
+        if (elapsed < frameMs)
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(frameMs - elapsed));
+
+        if (firstFrameMs < 0.0)
+            firstFrameMs = msSince(programStart);
+        if (loading) {
+            worstLoadingFrameMs = std::max(worstLoadingFrameMs, elapsed);
+            loadingFrames++;
+            if (allDone)
+                allReadyMs = msSince(programStart);
+        }
+    }
+    loader.stop();
+
+    std::printf("%s: primeiro frame em %.1f ms", stream ? "progressivo" : sync ? "sincrono" : "assincrono",
+                firstFrameMs);
+    if (allReadyMs >= 0.0)
+        std::printf(", tudo pronto em %.1f ms", allReadyMs);
+    else
+        std::printf(", carga nao terminou em %d frames", run.frameCount);
+    std::printf("\n  frames durante a carga: %d (pior: %.1f ms)\n", loadingFrames, worstLoadingFrameMs);
+    for (size_t m = 0; m < meshes.size(); m++) {
+        const AsyncMesh& a = *meshes[m];
+        std::printf("  %-28s %s  carga %8.1f ms", a.path.c_str(), a.ready() ? "pronto" : "falhou", a.readyMs);
+        if (readyAt[m] >= 0.0)
+            std::printf("  | na tela em %8.1f ms", readyAt[m]);
+        if (!streams.empty() && visibleAt[m] >= 0.0)
+            std::printf("  | primeiro lote em %8.1f ms", visibleAt[m]);
+        std::printf("\n");
+        if (!streams.empty() && !a.failed()) {
+            // O vBuffer completo do loadSimpleOBJ teria 72 bytes por triângulo
+            const ObjStream& s = *streams[m];
+            std::printf("    %zu triangulos, pico de memoria da CPU %.1f MB (vBuffer completo: %.1f MB)\n",
+                        s.trianglesTotal(), s.peakHostMemory() / (1024.0 * 1024.0),
+                        s.trianglesTotal() * 72.0 / (1024.0 * 1024.0));
+        }
+    }
+
+    // Limpa recursos alocados
+    for (size_t m = 0; m < meshes.size(); m++) {
+        if (meshes[m]->ready())
+            destroyMesh(meshes[m]->mesh);
+        else if (!streams.empty())
+            destroyMesh(streams[m]->mesh());
+    }
+    glDeleteProgram(shaderProgram);
+    if (!keep) {
+        for (size_t p = objFiles.size(); p < paths.size(); p++) {
+            std::remove(paths[p].c_str());
+            std::remove(meshCachePath(paths[p]).c_str());
+        }
+    }
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
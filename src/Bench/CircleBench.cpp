@@ -0,0 +1,278 @@
+/*
+ *  Benchmark dos círculos por instância (Common/CircleRenderer.h) contra o
+ *  jeito antigo do test.cpp: um vector de vértices, um VAO/VBO e um
+ *  glDrawArrays(GL_TRIANGLE_FAN) por círculo.
+ *
+ *  Uso: circlebench [--circles N] [--segments S] [--per-vao] [--animate] [opções do RunMode.h]
+ *    --circles N   círculos (padrão: 100000)
+ *    --segments S  segmentos de cada círculo (padrão: 36, como as rodas do test.cpp)
+ *    --per-vao     um VAO/VBO e uma chamada de desenho por círculo
+ *    --procedural  (do RunMode.h) círculos gerados no vertex shader a partir
+ *                  de centro e raio, sem VBO de vértices (ProceduralShape.h)
+ *    --animate     move os círculos a cada frame (instâncias reenviadas; no
+ *                  modo --per-vao, cada VBO é refeito)
+ *  Ex.: circlebench --headless --frames 200 --circles 100000 --profile circulos.json
+ *
+ *  Ao fim mostra o tempo de montagem, as chamadas de desenho por frame e o
+ *  tempo médio de frame.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+#include "CircleRenderer.h"
+#include "ProceduralShape.h"
+#include "RunMode.h"
+#include "ShaderProgram.h"
+#include "VertexFormat.h"
+
+const char* vertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"layout (location = 1) in vec3 aColor;\n"
+"out vec3 ourColor;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos, 1.0);\n"
+"   ourColor = aColor;\n"
+"}\0";
+
+const char* fragmentShaderSource = "#version 460 core\n"
+"in vec3 ourColor;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = vec4(ourColor, 1.0);\n"
+"}\0";
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+// Como o createCircle antigo do test.cpp (posição xyz + cor rgb por vértice)
+std::vector<float> createCircle(float cx, float cy, float r, int num_segments, float r_color, float g_color, float b_color) {
+    std::vector<float> vertices;
+    float center[6] = {cx, cy, 0.0f, r_color, g_color, b_color};
+    vertices.insert(vertices.end(), center, center + 6);
+    for (int i = 0; i <= num_segments; i++) {
+        float theta = 2.0f * 3.1415926f * float(i) / float(num_segments);
+        float v[6] = {cx + r * cosf(theta), cy + r * sinf(theta), 0.0f, r_color, g_color, b_color};
+        vertices.insert(vertices.end(), v, v + 6);
+    }
+    return vertices;
+}
+
+// Círculo i (determinístico); com `time`, gira em volta da posição inicial
+void circleParams(int i, int count, float time, glm::vec2& center, float& radius, glm::vec3& color)
+{
+    float a = i * 2.39996f, r = std::sqrt((i + 0.5f) / count) * 0.95f;
+    center = glm::vec2(r * std::cos(a) + 0.02f * std::cos(time + i), r * std::sin(a) + 0.02f * std::sin(time + i));
+    radius = std::max(0.002f, 1.5f / std::sqrt((float)count) * (0.5f + 0.5f * ((i * 7) % 10) / 10.0f));
+    color = glm::vec3(0.5f + 0.5f * std::sin(a), 0.5f + 0.5f * std::sin(a + 2.1f), 0.5f + 0.5f * std::sin(a + 4.2f));
+}
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+
+    int count = 100000;
+    int segments = 36;
+    bool perVao = false, animate = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--circles" && hasValue)
+            count = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--segments" && hasValue)
+            segments = std::max(3, std::atoi(argv[++i]));
+        else if (arg == "--per-vao")
+            perVao = true;
+        else if (arg == "--animate")
+            animate = true;
+    }
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "Circulos por instancia");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    auto t0 = std::chrono::steady_clock::now();
+    GLuint shaderProgram = 0;
+    std::vector<GLuint> VAOs, VBOs;
+    std::vector<GLsizei> vertexCounts;
+    CircleRenderer circles;
+    ProceduralShapes shapes;
+    if (perVao) {
+        shaderProgram = compileShaderProgram(vertexShaderSource, fragmentShaderSource);
+        VAOs.resize(count);
+        VBOs.resize(count);
+        glGenVertexArrays(count, VAOs.data());
+        glGenBuffers(count, VBOs.data());
+        for (int i = 0; i < count; i++) {
+            glm::vec2 c;
+            float r;
+            glm::vec3 color;
+            circleParams(i, count, 0.0f, c, r, color);
+            std::vector<float> vertices = createCircle(c.x, c.y, r, segments, color.r, color.g, color.b);
+            glBindVertexArray(VAOs[i]);
+            glBindBuffer(GL_ARRAY_BUFFER, VBOs[i]);
+            uploadShapeVertices(vertices, run.packedVertices);
+            vertexCounts.push_back((GLsizei)(vertices.size() / 6));
+        }
+        glBindVertexArray(0);
+    } else if (run.procedural) {
+        shapes.init();
+        for (int i = 0; i < count; i++) {
+            glm::vec2 c;
+            float r;
+            glm::vec3 color;
+            circleParams(i, count, 0.0f, c, r, color);
+            shapes.add(proceduralCircle(c, r, segments, shapeColor(color)));
+        }
+    } else {
+        circles.init(segments);
+        for (int i = 0; i < count; i++) {
+            glm::vec2 c;
+            float r;
+            glm::vec3 color;
+            circleParams(i, count, 0.0f, c, r, color);
+            circles.add(c, r, color);
+        }
+    }
+    glFinish();
+    double setupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    double frameMsTotal = 0.0;
+    int measured = 0;
+    size_t drawCalls = 0;
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        auto frameStart = std::chrono::steady_clock::now();
+        float time = (float)run.frameCount / 60.0f;
+
+        // Processa entrada
+        processInput(window);
+
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        drawCalls = 0;
+        if (perVao) {
+            glUseProgram(shaderProgram);
+            for (int i = 0; i < count; i++) {
+                glBindVertexArray(VAOs[i]);
+                if (animate) {
+                    glm::vec2 c;
+                    float r;
+                    glm::vec3 color;
+                    circleParams(i, count, time, c, r, color);
+                    std::vector<float> vertices = createCircle(c.x, c.y, r, segments, color.r, color.g, color.b);
+                    glBindBuffer(GL_ARRAY_BUFFER, VBOs[i]);
+                    uploadShapeVertices(vertices, run.packedVertices, GL_DYNAMIC_DRAW);
+                }
+                glDrawArrays(GL_TRIANGLE_FAN, 0, vertexCounts[i]);
+                drawCalls++;
+            }
+            glBindVertexArray(0);
+        } else if (run.procedural) {
+            if (animate) {
+                for (int i = 0; i < count; i++) {
+                    glm::vec2 c;
+                    float r;
+                    glm::vec3 color;
+                    circleParams(i, count, time, c, r, color);
+                    shapes.set(i, proceduralCircle(c, r, segments, shapeColor(color)));
+                }
+            }
+            shapes.draw();
+            drawCalls++;
+        } else {
+            if (animate) {
+                for (int i = 0; i < count; i++) {
+                    glm::vec2 c;
+                    float r;
+                    glm::vec3 color;
+                    circleParams(i, count, time, c, r, color);
+                    circles.set(i, c, r, color);
+                }
+            }
+            circles.draw();
+            drawCalls++;
+        }
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+        if (run.frameCount > run.warmup) {
+            frameMsTotal += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+            measured++;
+        }
+    }
+
+    std::printf("%s: %d circulos de %d segmentos, montagem em %.1f ms\n", perVao ? "um VAO por circulo" : run.procedural ? "procedural" : "instancias",
+                count, segments, setupMs);
+    std::printf("  %zu chamadas de desenho por frame, %.3f ms por frame (media de %d)\n", drawCalls,
+                measured ? frameMsTotal / measured : 0.0, measured);
+
+    // Limpa recursos alocados
+    if (perVao) {
+        glDeleteVertexArrays(count, VAOs.data());
+        glDeleteBuffers(count, VBOs.data());
+        glDeleteProgram(shaderProgram);
+    } else {
+        circles.destroy();
+        shapes.destroy();
+    }
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
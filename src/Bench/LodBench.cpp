@@ -0,0 +1,301 @@
+/*
+ *  Benchmark dos níveis de detalhe (Common/MeshSimplifier.h): uma grade de
+ *  cópias de uma malha densa, das mais próximas às mais distantes da câmera,
+ *  desenhada sempre com o LOD 0 e depois com o LOD escolhido pelo tamanho de
+ *  cada cópia na tela (selectMeshLod).
+ *
+ *  Uso: lodbench [--tris N] [--obj arquivo] [--levels L] [--instances K] [--max-error P] [opções do RunMode.h]
+ *    --tris N       triângulos da esfera gerada (padrão: 200000)
+ *    --obj          usa um .obj no lugar da esfera
+ *    --levels L     níveis da cadeia, contando o original (padrão: 6)
+ *    --instances K  cópias na grade (padrão: 64)
+ *    --max-error P  erro máximo tolerado na tela, em pixels (padrão: 1)
+ *  Ex.: lodbench --headless --frames 100 --size 1920x1080 --obj ../assets/Modelos3D/SuzanneSubdiv1.obj
+ *
+ *  Mostra o tempo de gerar a cadeia, os triângulos e o erro de cada nível,
+ *  quantas cópias usaram cada nível e, para os dois modos, os triângulos
+ *  enviados por frame e a média do tempo de GPU (GpuTimer.h).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+//GLM
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "GpuTimer.h"
+#include "MeshSimplifier.h"
+#include "ObjLoader.h"
+#include "RunMode.h"
+
+const char* vertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"uniform mat4 projection;\n"
+"uniform vec4 uOffsetScale;\n"
+"out vec3 worldPos;\n"
+"void main()\n"
+"{\n"
+"   worldPos = aPos * uOffsetScale.w + uOffsetScale.xyz;\n"
+"   gl_Position = projection * vec4(worldPos, 1.0);\n"
+"}\0";
+
+// Normal da face pelas derivadas da posição (a malha só tem posição e cor)
+const char* fragmentShaderSource = "#version 460 core\n"
+"in vec3 worldPos;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   vec3 n = normalize(cross(dFdx(worldPos), dFdy(worldPos)));\n"
+"   float diffuse = max(dot(n, normalize(vec3(0.4, 0.6, 0.7))), 0.0);\n"
+"   FragColor = vec4(vec3(0.9, 0.5, 0.2) * (0.2 + 0.8 * diffuse), 1.0);\n"
+"}\0";
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+GLuint compileProgram()
+{
+    int success;
+    char infoLog[512];
+    GLuint shaders[2] = {glCreateShader(GL_VERTEX_SHADER), glCreateShader(GL_FRAGMENT_SHADER)};
+    const char* sources[2] = {vertexShaderSource, fragmentShaderSource};
+    GLuint program = glCreateProgram();
+    for (int i = 0; i < 2; i++) {
+        glShaderSource(shaders[i], 1, &sources[i], NULL);
+        glCompileShader(shaders[i]);
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shaders[i], 512, NULL, infoLog);
+            std::cout << "ERRO::SHADER::COMPILACAO_FALHOU\n" << infoLog << std::endl;
+        }
+        glAttachShader(program, shaders[i]);
+    }
+    glLinkProgram(program);
+    glDeleteShader(shaders[0]);
+    glDeleteShader(shaders[1]);
+    return program;
+}
+
+// Esfera UV com ~`tris` triângulos (mesma do vertexlayoutbench, só posições)
+void buildSphere(int tris, ObjData& data)
+{
+    int stacks = std::max(2, (int)std::sqrt(tris / 4.0));
+    int slices = std::max(3, tris / (2 * stacks));
+    const float kPi = 3.14159265f;
+
+    for (int i = 0; i <= stacks; i++) {
+        float phi = kPi * i / stacks;
+        for (int j = 0; j <= slices; j++) {
+            float theta = 2.0f * kPi * j / slices;
+            data.vertices.push_back(glm::vec3(std::sin(phi) * std::cos(theta), std::cos(phi),
+                                              std::sin(phi) * std::sin(theta)));
+        }
+    }
+
+    for (int i = 0; i < stacks; i++) {
+        for (int j = 0; j < slices; j++) {
+            int a = i * (slices + 1) + j, b = a + slices + 1;
+            int quad[6] = {a, b, a + 1, a + 1, b, b + 1};
+            for (int k = 0; k < 6; k++)
+                data.corners.push_back({quad[k], -1, -1});
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+    int tris = 200000;
+    int levels = 6;
+    int instances = 64;
+    float maxError = 1.0f;
+    string objFile;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--tris") == 0)
+            tris = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--obj") == 0)
+            objFile = argv[++i];
+        else if (std::strcmp(argv[i], "--levels") == 0)
+            levels = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--instances") == 0)
+            instances = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--max-error") == 0)
+            maxError = (float)std::atof(argv[++i]);
+    }
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "LODs");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    GLuint shaderProgram = compileProgram();
+    GLint projectionLoc = glGetUniformLocation(shaderProgram, "projection");
+    GLint offsetScaleLoc = glGetUniformLocation(shaderProgram, "uOffsetScale");
+
+    ObjLoadOptions options;
+    options.optimize = true;
+    ObjData data;
+    std::vector<GLfloat> vBuffer;
+    std::vector<GLuint> indices;
+    if (!objFile.empty()) {
+        if (!parseIndexedOBJ(objFile, vBuffer, indices, options))
+            return -1;
+    } else {
+        buildSphere(tris, data);
+        buildIndexedBuffer(data, vBuffer, indices, options);
+        optimizeMesh(vBuffer, objVertexStride(options), indices);
+    }
+
+    Mesh mesh;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    buildMeshLods(vBuffer, objVertexStride(options), indices, levels, mesh.lods, NULL, true);
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    uploadIndexedMesh(vBuffer, indices, mesh, options);
+
+    // Escala para caber numa esfera de raio 1 (o erro dos LODs escala junto)
+    glm::vec3 center = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+    float radius = std::max(glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f, 1e-6f);
+    float scale = 1.0f / radius;
+
+    std::printf("%zu niveis gerados em %.1f ms\n", mesh.lods.size(), buildMs);
+    for (size_t l = 0; l < mesh.lods.size(); l++)
+        std::printf("  LOD %zu: %9d triangulos, erro %.5f\n", l, mesh.lods[l].indexCount / 3,
+                    mesh.lods[l].error * scale);
+
+    // Grade: colunas lado a lado, linhas cada vez mais longe (de 3 a ~150 unidades)
+    const float fovY = glm::radians(45.0f);
+    int columns = std::max(1, (int)std::ceil(std::sqrt((double)instances)));
+    int rows = (instances + columns - 1) / columns;
+    std::vector<glm::vec4> placements;
+    std::vector<int> selected;
+    std::vector<int> histogram(mesh.lods.size(), 0);
+    size_t lodTriangles = 0;
+    for (int k = 0; k < instances; k++) {
+        int row = k / columns, column = k % columns;
+        float distance = 3.0f * std::pow(50.0f, rows > 1 ? (float)row / (rows - 1) : 0.0f);
+        float spread = distance * std::tan(fovY * 0.5f) * (float)run.width / run.height;
+        float x = columns > 1 ? (-1.0f + 2.0f * (column + 0.5f) / columns) * spread : 0.0f;
+        placements.push_back(glm::vec4(x, 0.0f, -distance, scale));
+
+        int lod = selectMeshLod(mesh.lods, lodPixelsPerUnit(distance, fovY, run.height) * scale, maxError);
+        selected.push_back(lod);
+        histogram[lod]++;
+        lodTriangles += mesh.lods[lod].indexCount / 3;
+    }
+    std::printf("%d copias; por nivel:", instances);
+    for (size_t l = 0; l < histogram.size(); l++)
+        std::printf(" %d", histogram[l]);
+    std::printf("\n");
+
+    glm::mat4 projection = glm::perspective(fovY, (float)run.width / run.height, 0.1f, 500.0f);
+    glUseProgram(shaderProgram);
+    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+
+    GpuTimer gpuTimer(&run.profiler);
+    const char* names[2] = {"lod0", "lod"};
+    double totalMs[2] = {0.0, 0.0};
+    int samples[2] = {0, 0};
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        // Processa entrada
+        processInput(window);
+
+        for (int mode = 0; mode < 2; mode++) {
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            {
+                GpuTimer::Scope scope(gpuTimer, names[mode]);
+                for (int k = 0; k < instances; k++) {
+                    const glm::vec4& p = placements[k];
+                    glm::vec3 offset = glm::vec3(p.x, p.y, p.z) - center * p.w;
+                    glUniform4f(offsetScaleLoc, offset.x, offset.y, offset.z, p.w);
+                    drawMeshLod(mesh, mode == 0 ? 0 : selected[k]);
+                }
+            }
+
+            double ms = gpuTimer.lastGpuMs(names[mode]);
+            if (ms >= 0.0 && run.frameCount >= run.warmup) {
+                totalMs[mode] += ms;
+                samples[mode]++;
+            }
+        }
+
+        gpuTimer.endFrame();
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+    }
+
+    std::printf("GPU (media por frame):\n");
+    for (int mode = 0; mode < 2; mode++) {
+        size_t triangles = mode == 0 ? (size_t)instances * (mesh.lods[0].indexCount / 3) : lodTriangles;
+        std::printf("  %-5s %10zu triangulos  %8.3f ms\n", names[mode], triangles,
+                    samples[mode] ? totalMs[mode] / samples[mode] : -1.0);
+    }
+
+    // Limpa recursos alocados
+    gpuTimer.destroy();
+    destroyMesh(mesh);
+    glDeleteProgram(shaderProgram);
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
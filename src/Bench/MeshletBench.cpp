@@ -0,0 +1,312 @@
+/*
+ *  Benchmark do culling de meshlets (Common/Meshlets.h): um anel de cópias de
+ *  uma malha densa em volta da câmera, que gira devagar. Cada frame desenha o
+ *  anel inteiro com um glDrawElements por cópia e depois só os meshlets que
+ *  passaram no teste de frustum e de costas, com um glMultiDrawElements por cópia.
+ *
+ *  Uso: meshletbench [--tris N] [--obj arquivo] [--instances K] [opções do RunMode.h]
+ *    --tris N       triângulos da esfera gerada (padrão: 200000)
+ *    --obj          usa um .obj no lugar da esfera
+ *    --instances K  cópias no anel (padrão: 16)
+ *  Ex.: meshletbench --headless --frames 100 --size 1920x1080 --obj ../assets/Modelos3D/SuzanneSubdiv1.obj
+ *
+ *  Mostra quantos meshlets foram gerados (e o tempo), e para os dois modos os
+ *  triângulos enviados por frame e a média do tempo de GPU (GpuTimer.h); para
+ *  os meshlets, também o tempo de CPU do culling e quanto cada teste descartou.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+//GLM
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "GpuTimer.h"
+#include "Meshlets.h"
+#include "ObjLoader.h"
+#include "RunMode.h"
+
+const char* vertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"uniform mat4 viewProjection;\n"
+"uniform mat4 model;\n"
+"out vec3 worldPos;\n"
+"void main()\n"
+"{\n"
+"   worldPos = vec3(model * vec4(aPos, 1.0));\n"
+"   gl_Position = viewProjection * vec4(worldPos, 1.0);\n"
+"}\0";
+
+// Normal da face pelas derivadas da posição (a malha só tem posição e cor)
+const char* fragmentShaderSource = "#version 460 core\n"
+"in vec3 worldPos;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   vec3 n = normalize(cross(dFdx(worldPos), dFdy(worldPos)));\n"
+"   float diffuse = max(dot(n, normalize(vec3(0.4, 0.6, 0.7))), 0.0);\n"
+"   FragColor = vec4(vec3(0.9, 0.5, 0.2) * (0.2 + 0.8 * diffuse), 1.0);\n"
+"}\0";
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+GLuint compileProgram()
+{
+    int success;
+    char infoLog[512];
+    GLuint shaders[2] = {glCreateShader(GL_VERTEX_SHADER), glCreateShader(GL_FRAGMENT_SHADER)};
+    const char* sources[2] = {vertexShaderSource, fragmentShaderSource};
+    GLuint program = glCreateProgram();
+    for (int i = 0; i < 2; i++) {
+        glShaderSource(shaders[i], 1, &sources[i], NULL);
+        glCompileShader(shaders[i]);
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shaders[i], 512, NULL, infoLog);
+            std::cout << "ERRO::SHADER::COMPILACAO_FALHOU\n" << infoLog << std::endl;
+        }
+        glAttachShader(program, shaders[i]);
+    }
+    glLinkProgram(program);
+    glDeleteShader(shaders[0]);
+    glDeleteShader(shaders[1]);
+    return program;
+}
+
+// Esfera UV com ~`tris` triângulos, de frente para fora (o teste de costas depende disso)
+void buildSphere(int tris, ObjData& data)
+{
+    int stacks = std::max(2, (int)std::sqrt(tris / 4.0));
+    int slices = std::max(3, tris / (2 * stacks));
+    const float kPi = 3.14159265f;
+
+    for (int i = 0; i <= stacks; i++) {
+        float phi = kPi * i / stacks;
+        for (int j = 0; j <= slices; j++) {
+            float theta = 2.0f * kPi * j / slices;
+            data.vertices.push_back(glm::vec3(std::sin(phi) * std::cos(theta), std::cos(phi),
+                                              std::sin(phi) * std::sin(theta)));
+        }
+    }
+
+    for (int i = 0; i < stacks; i++) {
+        for (int j = 0; j < slices; j++) {
+            int a = i * (slices + 1) + j, b = a + slices + 1;
+            int quad[6] = {a, a + 1, b, a + 1, b + 1, b};
+            for (int k = 0; k < 6; k++)
+                data.corners.push_back({quad[k], -1, -1});
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+    int tris = 200000;
+    int instances = 16;
+    string objFile;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--tris") == 0)
+            tris = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--obj") == 0)
+            objFile = argv[++i];
+        else if (std::strcmp(argv[i], "--instances") == 0)
+            instances = std::max(1, std::atoi(argv[++i]));
+    }
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "Meshlets");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    GLuint shaderProgram = compileProgram();
+    GLint viewProjectionLoc = glGetUniformLocation(shaderProgram, "viewProjection");
+    GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
+
+    ObjLoadOptions options;
+    options.optimize = true;
+    ObjData data;
+    std::vector<GLfloat> vBuffer;
+    std::vector<GLuint> indices;
+    if (!objFile.empty()) {
+        if (!parseIndexedOBJ(objFile, vBuffer, indices, options))
+            return -1;
+    } else {
+        buildSphere(tris, data);
+        buildIndexedBuffer(data, vBuffer, indices, options);
+        optimizeMesh(vBuffer, objVertexStride(options), indices);
+    }
+
+    Mesh mesh;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    buildMeshlets(vBuffer, objVertexStride(options), indices, mesh.meshlets);
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    uploadIndexedMesh(vBuffer, indices, mesh, options);
+
+    size_t coned = 0;
+    for (const Meshlet& m : mesh.meshlets)
+        coned += m.coneCutoff < 1.0f;
+    std::printf("%d triangulos -> %zu meshlets (%zu com cone util) em %.1f ms\n", mesh.indexCount / 3,
+                mesh.meshlets.size(), coned, buildMs);
+
+    MeshletCuller culler;
+    culler.setMeshlets(mesh.meshlets);
+    MeshletDrawList drawList;
+
+    // Anel de cópias com raio 1 em volta da câmera (na origem)
+    glm::vec3 center = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+    float radius = std::max(glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f, 1e-6f);
+    float scale = 1.0f / radius;
+    const float ring = std::max(3.0f, instances * 2.5f / 6.2831853f);
+    std::vector<glm::mat4> models;
+    for (int k = 0; k < instances; k++) {
+        float angle = 6.2831853f * k / instances;
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * ring);
+        model = glm::scale(model, glm::vec3(scale));
+        models.push_back(glm::translate(model, -center));
+    }
+
+    const float fovY = glm::radians(45.0f);
+    glm::mat4 projection = glm::perspective(fovY, (float)run.width / run.height, 0.1f, 500.0f);
+    glUseProgram(shaderProgram);
+
+    GpuTimer gpuTimer(&run.profiler);
+    const char* names[2] = {"full", "meshlets"};
+    double totalMs[2] = {0.0, 0.0};
+    int samples[2] = {0, 0};
+    double cullMs = 0.0;
+    size_t submitted = 0, frustumCulled = 0, backfaceCulled = 0, ranges = 0;
+    int measured = 0;
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        // Processa entrada
+        processInput(window);
+
+        glm::mat4 view = glm::rotate(glm::mat4(1.0f), run.frameCount * 0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 viewProjection = projection * view;
+        glUniformMatrix4fv(viewProjectionLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+        bool counted = run.frameCount >= run.warmup;
+
+        for (int mode = 0; mode < 2; mode++) {
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            {
+                GpuTimer::Scope scope(gpuTimer, names[mode]);
+                for (int k = 0; k < instances; k++) {
+                    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(models[k]));
+                    if (mode == 0) {
+                        drawMesh(mesh);
+                        continue;
+                    }
+                    // A câmera está na origem do mundo
+                    glm::vec3 camera = glm::vec3(glm::inverse(models[k]) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+                    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+                    culler.cull(viewProjection * models[k], camera, mesh.indexType, drawList);
+                    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+                    drawMeshlets(mesh, drawList);
+                    if (counted) {
+                        cullMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+                        submitted += drawList.triangles;
+                        frustumCulled += drawList.frustumCulled;
+                        backfaceCulled += drawList.backfaceCulled;
+                        ranges += drawList.counts.size();
+                    }
+                }
+            }
+
+            double ms = gpuTimer.lastGpuMs(names[mode]);
+            if (ms >= 0.0 && counted) {
+                totalMs[mode] += ms;
+                samples[mode]++;
+            }
+        }
+        if (counted)
+            measured++;
+
+        gpuTimer.endFrame();
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+    }
+
+    if (measured > 0) {
+        size_t total = mesh.meshlets.size() * (size_t)instances * measured;
+        std::printf("Meshlets por frame: %.0f no frustum e de frente, %.1f%% fora do frustum, %.1f%% de costas; "
+                    "%.0f trechos; culling %.3f ms de CPU\n",
+                    (double)(total - frustumCulled - backfaceCulled) / measured, 100.0 * frustumCulled / total,
+                    100.0 * backfaceCulled / total, (double)ranges / measured, cullMs / measured);
+    }
+    std::printf("GPU (media por frame):\n");
+    for (int mode = 0; mode < 2; mode++) {
+        double triangles = mode == 0 ? (double)instances * (mesh.indexCount / 3)
+                                     : measured ? (double)submitted / measured : 0.0;
+        std::printf("  %-8s %12.0f triangulos  %8.3f ms\n", names[mode], triangles,
+                    samples[mode] ? totalMs[mode] / samples[mode] : -1.0);
+    }
+
+    // Limpa recursos alocados
+    gpuTimer.destroy();
+    destroyMesh(mesh);
+    glDeleteProgram(shaderProgram);
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
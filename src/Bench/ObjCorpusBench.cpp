@@ -0,0 +1,193 @@
+/*
+ *  Benchmark do leitor de .OBJ (Common/ObjLoader.h) sobre um conjunto de
+ *  arquivos sintéticos (Common/ObjGenerator.h): vários tamanhos, combinações
+ *  de atributos e tipos de face. Para cada arquivo mostra MB/s e milhões de
+ *  triângulos/s da leitura simples com 1 thread e com T threads e da saída
+ *  indexada, e no fim o total de cada modo, para regressões do leitor
+ *  aparecerem de uma execução para outra.
+ *
+ *  Uso: objcorpusbench [--tris N]... [--threads T] [--runs R] [--dir pasta] [--keep] [--csv arquivo]
+ *    --tris N   tamanho dos arquivos (pode repetir; padrão: 1000, 100000 e 1000000)
+ *    --threads  threads da leitura paralela (padrão: todos os núcleos)
+ *    --runs R   repetições de cada leitura; vale o menor tempo (padrão: 3)
+ *    --dir      onde ficam os .obj gerados (padrão: pasta atual)
+ *    --keep     não apaga os arquivos e reaproveita os que já existem (a geração é determinística)
+ *    --csv      acrescenta os resultados a um .csv (arquivo, modo, triângulos, MB, ms, MB/s, Mtri/s)
+ *  Ex.: objcorpusbench --tris 1000000 --tris 20000000 --dir /tmp --keep --csv leitor.csv
+ *
+ *  Só mede a parte de CPU; não precisa de contexto OpenGL.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+#include "ObjGenerator.h"
+#include "ObjLoader.h"
+
+template <class Fn>
+double bestTimeMs(int runs, Fn fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+long long fileSize(const string& path)
+{
+    std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+    return in.is_open() ? (long long)in.tellg() : -1;
+}
+
+// Variações de atributos e faces geradas para cada tamanho
+std::vector<ObjGenOptions> corpusVariants()
+{
+    struct Variant
+    {
+        bool texCoords, normals;
+        ObjGenFaces faces;
+        bool relative;
+    };
+    const Variant variants[] = {
+        {false, false, ObjGenFaces::Triangles, false},  // "v"
+        {true, false, ObjGenFaces::Triangles, false},   // "v/vt"
+        {false, true, ObjGenFaces::Triangles, false},   // "v//vn"
+        {true, true, ObjGenFaces::Triangles, false},    // "v/vt/vn"
+        {true, true, ObjGenFaces::Quads, false},
+        {false, true, ObjGenFaces::Polygons, false},
+        {true, true, ObjGenFaces::Triangles, true},     // índices negativos
+    };
+    std::vector<ObjGenOptions> result;
+    for (const Variant& v : variants) {
+        ObjGenOptions options;
+        options.texCoords = v.texCoords;
+        options.normals = v.normals;
+        options.faces = v.faces;
+        options.relativeIndices = v.relative;
+        result.push_back(options);
+    }
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<long long> sizes;
+    int runs = 3;
+    string dir = ".";
+    bool keep = false;
+    string csvPath;
+    int threads = resolveThreadCount(0);
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--tris" && i + 1 < argc)
+            sizes.push_back(std::atoll(argv[++i]));
+        else if (arg == "--runs" && i + 1 < argc)
+            runs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--dir" && i + 1 < argc)
+            dir = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--keep")
+            keep = true;
+        else if (arg == "--csv" && i + 1 < argc)
+            csvPath = argv[++i];
+    }
+    if (sizes.empty())
+        sizes = {1000, 100000, 1000000};
+
+    FILE* csv = NULL;
+    if (!csvPath.empty()) {
+        bool exists = fileSize(csvPath) > 0;
+        csv = std::fopen(csvPath.c_str(), "a");
+        if (csv && !exists)
+            std::fprintf(csv, "arquivo,modo,triangulos,mb,ms,mb_s,mtri_s\n");
+    }
+
+    const int kModes = 3;
+    char modeNames[kModes][16];
+    std::snprintf(modeNames[0], sizeof(modeNames[0]), "simples 1T");
+    std::snprintf(modeNames[1], sizeof(modeNames[1]), "simples %dT", threads);
+    std::snprintf(modeNames[2], sizeof(modeNames[2]), "indexado %dT", threads);
+    double totalMs[kModes] = {0.0, 0.0, 0.0};
+    double totalMB = 0.0, totalTris = 0.0;
+    bool allMatch = true;
+
+    ObjLoadOptions single;
+    single.threads = 1;
+    ObjLoadOptions parallel;
+    parallel.threads = threads;
+
+    std::printf("%-32s %10s %9s | %-29s | %-29s | %-29s\n", "arquivo", "tris", "MB", modeNames[0], modeNames[1],
+                modeNames[2]);
+    for (long long tris : sizes) {
+        for (ObjGenOptions options : corpusVariants()) {
+            options.triangles = tris;
+            string name = objGenFileName(options);
+            string path = dir + "/" + name;
+            bool reused = keep && fileSize(path) > 0;
+            if (!reused && !generateOBJ(path, options)) {
+                std::cerr << "Erro ao gerar " << path << std::endl;
+                return -1;
+            }
+            double mb = fileSize(path) / (1024.0 * 1024.0);
+
+            std::vector<GLfloat> flat, flatMT, vBuffer;
+            std::vector<GLuint> indices;
+            double ms[kModes];
+            ms[0] = bestTimeMs(runs, [&] { flat.clear(); parseSimpleOBJ(path, flat, single); });
+            ms[1] = bestTimeMs(runs, [&] { flatMT.clear(); parseSimpleOBJ(path, flatMT, parallel); });
+            ms[2] = bestTimeMs(runs, [&] { parseIndexedOBJ(path, vBuffer, indices, parallel); });
+
+            // As três leituras têm que dar os mesmos triângulos
+            size_t nTris = flat.size() / 18;
+            bool match = flat.size() == flatMT.size() &&
+                         std::memcmp(flat.data(), flatMT.data(), flat.size() * sizeof(GLfloat)) == 0 &&
+                         indices.size() / 3 == nTris && nTris > 0;
+            allMatch = allMatch && match;
+
+            std::printf("%-32s %10zu %9.1f", name.c_str(), nTris, mb);
+            for (int m = 0; m < kModes; m++) {
+                double mbs = mb / (ms[m] / 1000.0), mtris = nTris / (ms[m] * 1000.0);
+                std::printf(" | %8.1f ms %7.1f MB/s %5.1fM", ms[m], mbs, mtris);
+                totalMs[m] += ms[m];
+                if (csv)
+                    std::fprintf(csv, "%s,%s,%zu,%.3f,%.3f,%.2f,%.3f\n", name.c_str(), modeNames[m], nTris, mb,
+                                 ms[m], mbs, mtris);
+            }
+            std::printf("%s\n", match ? "" : "  DIFERENTE");
+            totalMB += mb;
+            totalTris += (double)nTris;
+
+            if (!keep)
+                std::remove(path.c_str());
+        }
+    }
+
+    std::printf("Total: %.1f MB, %.1f milhoes de triangulos\n", totalMB, totalTris / 1e6);
+    for (int m = 0; m < kModes; m++)
+        std::printf("  %-13s %9.1f ms  %8.1f MB/s  %6.2f Mtri/s\n", modeNames[m], totalMs[m],
+                    totalMB / (totalMs[m] / 1000.0), totalTris / (totalMs[m] * 1000.0));
+    if (csv)
+        std::fclose(csv);
+
+    return allMatch ? 0 : 1;
+}
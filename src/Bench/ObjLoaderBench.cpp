@@ -0,0 +1,313 @@
+/*
+ *  Benchmark do leitor de .OBJ: compara o laço original do loadSimpleOBJ
+ *  ("Code snippets/LoadSimpleOBJ.cpp", istringstream por linha) com o leitor
+ *  de Common/ObjLoader.h em arquivos gerados com muitos triângulos.
+ *
+ *  Uso: objloaderbench [--tris N] [--obj arquivo] [--threads T] [--runs R] [--dir pasta] [--keep] [--skip-original]
+ *    --tris N   gera um arquivo com ~N triângulos (padrão: 100000, 1000000 e 4000000)
+ *    --obj      mede também um .obj existente (ex.: ../assets/Modelos3D/SuzanneSubdiv1.obj)
+ *    --threads  threads da leitura paralela (padrão: todos os núcleos); o leitor
+ *               rápido roda com 1 thread e com T threads
+ *    --skip-original  não roda o laço original (lento demais em arquivos enormes)
+ *    --runs R   repetições de cada leitor; vale o menor tempo (padrão: 3)
+ *    --dir      onde gravar os .obj gerados (padrão: pasta atual)
+ *    --keep     não apaga os arquivos gerados
+ *
+ *  Também mede a saída indexada (parseIndexedOBJ): vértices únicos, tamanho
+ *  de vértices + índices comparado ao buffer expandido, e confere que expandir
+ *  os índices reproduz o vBuffer. Por fim roda o optimizeMesh (MeshOptimizer.h)
+ *  e mostra ACMR/ATVR antes e depois, e o tempo de abrir o cache binário
+ *  (MeshCache.h) no lugar do .obj.
+ *
+ *  Só mede a parte de CPU (leitura + montagem do vBuffer); não precisa de contexto OpenGL.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "MeshCache.h"
+#include "ObjGenerator.h"
+#include "ObjLoader.h"
+
+// Laço de leitura do loadSimpleOBJ original, sem a parte de OpenGL (referência)
+bool parseSimpleOBJReference(string filePATH, std::vector<GLfloat>& vBuffer)
+{
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    glm::vec3 color = glm::vec3(1.0, 0.0, 0.0);
+
+    std::ifstream arqEntrada(filePATH.c_str());
+    if (!arqEntrada.is_open())
+    {
+        std::cerr << "Erro ao tentar ler o arquivo " << filePATH << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(arqEntrada, line))
+    {
+        std::istringstream ssline(line);
+        std::string word;
+        ssline >> word;
+
+        if (word == "v")
+        {
+            glm::vec3 vertice;
+            ssline >> vertice.x >> vertice.y >> vertice.z;
+            vertices.push_back(vertice);
+        }
+        else if (word == "vt")
+        {
+            glm::vec2 vt;
+            ssline >> vt.s >> vt.t;
+            texCoords.push_back(vt);
+        }
+        else if (word == "vn")
+        {
+            glm::vec3 normal;
+            ssline >> normal.x >> normal.y >> normal.z;
+            normals.push_back(normal);
+        }
+        else if (word == "f")
+        {
+            while (ssline >> word)
+            {
+                int vi = 0, ti = 0, ni = 0;
+                std::istringstream ss(word);
+                std::string index;
+
+                if (std::getline(ss, index, '/')) vi = !index.empty() ? std::stoi(index) - 1 : 0;
+                if (std::getline(ss, index, '/')) ti = !index.empty() ? std::stoi(index) - 1 : 0;
+                if (std::getline(ss, index)) ni = !index.empty() ? std::stoi(index) - 1 : 0;
+                (void)ti;   // lidos e descartados, como no original
+                (void)ni;
+
+                vBuffer.push_back(vertices[vi].x);
+                vBuffer.push_back(vertices[vi].y);
+                vBuffer.push_back(vertices[vi].z);
+                vBuffer.push_back(color.r);
+                vBuffer.push_back(color.g);
+                vBuffer.push_back(color.b);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Confere se duas malhas indexadas têm os mesmos triângulos (posição e cor dos
+// cantos, mesma orientação), em qualquer ordem e com qualquer numeração de vértices
+bool sameTriangles(const std::vector<GLfloat>& vA, const std::vector<GLuint>& iA,
+                   const std::vector<GLfloat>& vB, const std::vector<GLuint>& iB)
+{
+    typedef std::vector<GLfloat> Tri;
+    auto collect = [](const std::vector<GLfloat>& v, const std::vector<GLuint>& idx) {
+        std::vector<Tri> tris(idx.size() / 3);
+        for (size_t t = 0; t < tris.size(); t++) {
+            Tri corners[3];
+            for (int c = 0; c < 3; c++)
+                corners[c].assign(v.begin() + idx[t * 3 + c] * 6, v.begin() + idx[t * 3 + c] * 6 + 6);
+            // Rotação que começa pelo menor canto (preserva a orientação)
+            int first = 0;
+            for (int c = 1; c < 3; c++)
+                if (corners[c] < corners[first])
+                    first = c;
+            for (int c = 0; c < 3; c++)
+                tris[t].insert(tris[t].end(), corners[(first + c) % 3].begin(), corners[(first + c) % 3].end());
+        }
+        std::sort(tris.begin(), tris.end());
+        return tris;
+    };
+    return iA.size() == iB.size() && collect(vA, iA) == collect(vB, iB);
+}
+
+template <class Fn>
+double bestTimeMs(int runs, Fn fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+long long fileSize(const string& path)
+{
+    std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+    return in.is_open() ? (long long)in.tellg() : 0;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<long long> sizes;
+    std::vector<string> objFiles;
+    int runs = 3;
+    string dir = ".";
+    bool keep = false;
+    bool skipOriginal = false;
+    int threads = resolveThreadCount(0);
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--tris" && i + 1 < argc)
+            sizes.push_back(std::atoll(argv[++i]));
+        else if (arg == "--obj" && i + 1 < argc)
+            objFiles.push_back(argv[++i]);
+        else if (arg == "--runs" && i + 1 < argc)
+            runs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--dir" && i + 1 < argc)
+            dir = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--keep")
+            keep = true;
+        else if (arg == "--skip-original")
+            skipOriginal = true;
+    }
+    if (sizes.empty() && objFiles.empty())
+        sizes = {100000, 1000000, 4000000};
+
+    // Arquivos passados com --obj entram na lista sem ser gerados nem apagados
+    std::vector<string> paths(objFiles);
+    for (long long tris : sizes) {
+        // Grade ondulada com v/vt/vn e faces triangulares "v/vt/vn" (ObjGenerator.h)
+        ObjGenOptions gen;
+        gen.triangles = tris;
+        gen.texCoords = true;
+        gen.normals = true;
+        string path = dir + "/bench_" + std::to_string(tris) + ".obj";
+        if (!generateOBJ(path, gen)) {
+            std::cerr << "Erro ao gerar " << path << std::endl;
+            return -1;
+        }
+        paths.push_back(path);
+    }
+
+    bool allMatch = true;
+    for (size_t p = 0; p < paths.size(); p++) {
+        const string& path = paths[p];
+        bool generated = p >= objFiles.size();
+        if (!generated)
+            std::cout << path << std::endl;
+        double mb = fileSize(path) / (1024.0 * 1024.0);
+
+        ObjLoadOptions single;
+        single.threads = 1;
+        ObjLoadOptions parallel;
+        parallel.threads = threads;
+
+        std::vector<GLfloat> reference, fast, fastMT;
+        double refMs = 0.0;
+        if (!skipOriginal)
+            refMs = bestTimeMs(runs, [&] { reference.clear(); parseSimpleOBJReference(path, reference); });
+        double fastMs = bestTimeMs(runs, [&] { fast.clear(); parseSimpleOBJ(path, fast, single); });
+        double mtMs = bestTimeMs(runs, [&] { fastMT.clear(); parseSimpleOBJ(path, fastMT, parallel); });
+
+        auto same = [](const std::vector<GLfloat>& a, const std::vector<GLfloat>& b) {
+            return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(GLfloat)) == 0;
+        };
+        bool match = (skipOriginal || same(reference, fast)) && same(fast, fastMT);
+        allMatch = allMatch && match;
+
+        size_t nTris = fast.size() / 18;
+        char line[320];
+        if (skipOriginal)
+            std::snprintf(line, sizeof(line), "%9zu tris  %7.1f MB | original        -", nTris, mb);
+        else
+            std::snprintf(line, sizeof(line), "%9zu tris  %7.1f MB | original %9.1f ms (%6.1f MB/s)",
+                          nTris, mb, refMs, mb / (refMs / 1000.0));
+        std::cout << line;
+        std::snprintf(line, sizeof(line),
+                      " | rapido 1T %8.1f ms (%7.1f MB/s) | %dT %8.1f ms (%7.1f MB/s, %4.1fx) | vBuffer %s",
+                      fastMs, mb / (fastMs / 1000.0), threads, mtMs, mb / (mtMs / 1000.0),
+                      fastMs / mtMs, match ? "igual" : "DIFERENTE");
+        std::cout << line << std::endl;
+
+        std::vector<GLfloat> indexedVerts;
+        std::vector<GLuint> indices;
+        double idxMs = bestTimeMs(runs, [&] { parseIndexedOBJ(path, indexedVerts, indices, parallel); });
+
+        bool idxMatch = indices.size() * 6 == fast.size();
+        for (size_t i = 0; idxMatch && i < indices.size(); i++)
+            idxMatch = std::memcmp(&indexedVerts[indices[i] * 6], &fast[i * 6], 6 * sizeof(GLfloat)) == 0;
+        allMatch = allMatch && idxMatch;
+
+        size_t nUnique = indexedVerts.size() / 6;
+        size_t indexBytes = indices.size() * (nUnique <= 65536 ? 2 : 4);
+        double flatMB = fast.size() * sizeof(GLfloat) / (1024.0 * 1024.0);
+        double idxMB = (indexedVerts.size() * sizeof(GLfloat) + indexBytes) / (1024.0 * 1024.0);
+        std::snprintf(line, sizeof(line),
+                      "%9s indexado %8.1f ms | %zu vértices únicos de %zu (%.1fx) | %.1f MB -> %.1f MB | expansão %s",
+                      "", idxMs, nUnique, indices.size(), (double)indices.size() / std::max<size_t>(nUnique, 1),
+                      flatMB, idxMB, idxMatch ? "igual" : "DIFERENTE");
+        std::cout << line << std::endl;
+
+        // Cache binário: grava e mede a abertura (mapeamento + validação + leitura
+        // de todas as páginas, que é o que o glBufferData faria)
+        string cachePath = dir + "/bench_cache.mesh";
+        writeMeshCache(cachePath, path, indexedVerts, indices);
+        bool cacheOk = false;
+        unsigned long long touched = 0;
+        double cacheMs = bestTimeMs(runs, [&] {
+            MeshCacheFile cache;
+            cacheOk = cache.open(cachePath, path, 0);
+            if (!cacheOk)
+                return;
+            const MeshCacheHeader& h = cache.info();
+            const unsigned char* v = (const unsigned char*)cache.vertices();
+            const unsigned char* ix = (const unsigned char*)cache.indices();
+            for (size_t b = 0; b < h.vertexBytes; b += 4096)
+                touched += v[b];
+            for (size_t b = 0; b < h.indexBytes; b += 4096)
+                touched += ix[b];
+        });
+        allMatch = allMatch && cacheOk;
+        std::snprintf(line, sizeof(line), "%9s cache     %7.2f ms | %.1f MB | %s | %.0fx mais rápido que ler o .obj",
+                      "", cacheMs, fileSize(cachePath) / (1024.0 * 1024.0), cacheOk ? "válido" : "INVÁLIDO",
+                      idxMs / std::max(cacheMs, 1e-3));
+        std::cout << line << std::endl;
+        std::remove(cachePath.c_str());
+
+        // Otimização para o cache de vértices (sobre a saída indexada)
+        std::vector<GLfloat> optVerts = indexedVerts;
+        std::vector<GLuint> optIndices = indices;
+        auto t0 = std::chrono::steady_clock::now();
+        MeshOptimizeStats stats = optimizeMesh(optVerts, 6, optIndices);
+        double optMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        bool optMatch = sameTriangles(indexedVerts, indices, optVerts, optIndices);
+        allMatch = allMatch && optMatch;
+        std::snprintf(line, sizeof(line), "%9s otimizado %7.1f ms | triangulos %s | ", "", optMs,
+                      optMatch ? "iguais" : "DIFERENTES");
+        std::cout << line;
+        printMeshOptimizeStats(stats);
+
+        if (generated && !keep)
+            std::remove(path.c_str());
+    }
+
+    return allMatch ? 0 : 1;
+}
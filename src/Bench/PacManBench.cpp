@@ -0,0 +1,225 @@
+/*
+ *  Benchmark do Pac-Man animado (Common/PacManRenderer.h): N Pac-Men mastigando
+ *  e girando, com a boca recortada no shader e nenhum envio por frame, contra
+ *  (--rebuild) o jeito do Ex7-c: refazer na CPU os vértices e os triângulos da
+ *  fatia de cada um a cada frame e enviar tudo (um VBO só, uma chamada).
+ *
+ *  Uso: pacmanbench [--pacmen N] [--steps S] [--rebuild] [opções do RunMode.h]
+ *    --pacmen N  Pac-Men (padrão: 5000)
+ *    --steps S   segmentos do círculo no --rebuild (padrão: 30, como o Ex7-c)
+ *    --rebuild   geometria refeita e enviada a cada frame
+ *  Ex.: pacmanbench --headless --frames 300 --pacmen 10000 --profile pacman.json
+ *
+ *  Ao fim mostra os bytes enviados por frame e o tempo médio de frame.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+#include "PacManRenderer.h"
+#include "RunMode.h"
+#include "ShaderProgram.h"
+
+const char* vertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec2 aPos;\n"
+"layout (location = 1) in vec4 aColor;\n"
+"out vec4 ourColor;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos, 0.0, 1.0);\n"
+"   ourColor = aColor;\n"
+"}\0";
+
+const char* fragmentShaderSource = "#version 460 core\n"
+"in vec4 ourColor;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = ourColor;\n"
+"}\0";
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+// Vértice do --rebuild (posição + cor RGBA8)
+struct PacVertex
+{
+    float x, y;
+    uint32_t color;
+};
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+
+    int count = 5000;
+    int steps = 30;
+    bool rebuild = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--pacmen" && hasValue)
+            count = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--steps" && hasValue)
+            steps = std::max(3, std::atoi(argv[++i]));
+        else if (arg == "--rebuild")
+            rebuild = true;
+    }
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "Pac-Man animado");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    // Posição, raio, direção e fase de cada Pac-Man (determinísticos)
+    const float mouth = 1.5f, chewRate = 3.0f, spin = 0.5f;
+    std::vector<glm::vec4> pacmen(count);
+    std::vector<float> phases(count);
+    float radius = std::min(0.1f, 1.2f / std::sqrt((float)count));
+    for (int i = 0; i < count; i++) {
+        float a = i * 2.39996f, r = std::sqrt((i + 0.5f) / count) * 0.95f;
+        pacmen[i] = glm::vec4(r * std::cos(a), r * std::sin(a), radius, a);
+        phases[i] = (i % 17) / 17.0f;
+    }
+
+    PacManRenderer renderer;
+    GLuint shaderProgram = 0, VAO = 0, VBO = 0;
+    std::vector<PacVertex> vertices;
+    if (rebuild) {
+        shaderProgram = compileShaderProgram(vertexShaderSource, fragmentShaderSource);
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PacVertex), (GLvoid*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PacVertex), (GLvoid*)offsetof(PacVertex, color));
+        glEnableVertexAttribArray(1);
+        glBindVertexArray(0);
+    } else {
+        renderer.init();
+        renderer.setMouth(mouth);
+        renderer.setChewRate(chewRate);
+        for (int i = 0; i < count; i++)
+            renderer.add(glm::vec2(pacmen[i].x, pacmen[i].y), pacmen[i].z, pacmen[i].w, glm::vec3(1.0f, 1.0f, 0.0f), phases[i]);
+    }
+
+    double frameMsTotal = 0.0;
+    int measured = 0;
+    size_t uploadBytes = 0;
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        auto frameStart = std::chrono::steady_clock::now();
+        float time = (float)run.frameCount / 60.0f;
+
+        // Processa entrada
+        processInput(window);
+
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        if (rebuild) {
+            // Leque da parte fechada de cada um, como os triângulos do Ex7-c
+            vertices.clear();
+            const float step = 6.2831853f / steps;
+            for (int i = 0; i < count; i++) {
+                float open = 0.5f - 0.5f * std::cos(6.2831853f * (time * chewRate + phases[i]));
+                float halfMouth = 0.5f * mouth * open;
+                float facing = pacmen[i].w + spin * time;
+                int segments = std::max(1, (int)std::ceil((6.2831853f - 2.0f * halfMouth) / step));
+                float start = facing + halfMouth, span = (6.2831853f - 2.0f * halfMouth) / segments;
+                PacVertex center = {pacmen[i].x, pacmen[i].y, 0xFF00FFFFu};
+                for (int k = 0; k < segments; k++) {
+                    float a0 = start + span * k, a1 = a0 + span;
+                    PacVertex v0 = {pacmen[i].x + pacmen[i].z * std::cos(a0), pacmen[i].y + pacmen[i].z * std::sin(a0), 0xFF00FFFFu};
+                    PacVertex v1 = {pacmen[i].x + pacmen[i].z * std::cos(a1), pacmen[i].y + pacmen[i].z * std::sin(a1), 0xFF00FFFFu};
+                    vertices.push_back(center);
+                    vertices.push_back(v0);
+                    vertices.push_back(v1);
+                }
+            }
+            uploadBytes = vertices.size() * sizeof(PacVertex);
+            glBindBuffer(GL_ARRAY_BUFFER, VBO);
+            glBufferData(GL_ARRAY_BUFFER, uploadBytes, vertices.data(), GL_STREAM_DRAW);
+            glUseProgram(shaderProgram);
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.size());
+            glBindVertexArray(0);
+        } else {
+            renderer.setFacing(spin * time);
+            renderer.draw(time);
+        }
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+        if (run.frameCount > run.warmup) {
+            frameMsTotal += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+            measured++;
+        }
+    }
+
+    std::printf("%s: %d Pac-Men, %zu bytes enviados por frame\n", rebuild ? "geometria refeita" : "shader", count,
+                uploadBytes);
+    std::printf("  %.3f ms por frame (media de %d)\n", measured ? frameMsTotal / measured : 0.0, measured);
+
+    // Limpa recursos alocados
+    renderer.destroy();
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteProgram(shaderProgram);
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ *  Benchmark do cache de programas (Common/ProgramCache.h): cria N
+ *  permutações de um mesmo programa (o fragment shader com "#define VARIANT i",
+ *  como um sistema de materiais faria) e mede quanto tempo leva para ter
+ *  todas prontas. Faz duas passadas no mesmo processo: na primeira, com a
+ *  pasta vazia (--clear), tudo é compilado e gravado; na segunda, tudo vem
+ *  dos binários. Rodar de novo sem --clear mostra a partida "quente".
+ *
+ *  Uso: shadercachebench [--permutations N] [--clear] [opções do RunMode.h]
+ *    --permutations N  programas distintos (padrão: 64)
+ *    --clear           apaga a pasta do cache antes da primeira passada
+ *  Ex.: shadercachebench --headless --clear
+ *       shadercachebench --headless --no-shader-cache   (só compila, para comparar)
+ *
+ *  Cada programa é desenhado uma vez (um triângulo) para o driver terminar
+ *  qualquer trabalho adiado do link antes de parar o relógio.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+#include "ProgramCache.h"
+#include "RunMode.h"
+
+const char* vertexShaderSource = "#version 400\n"
+"out vec2 uv;\n"
+"void main()\n"
+"{\n"
+"   uv = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0;\n"
+"   gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);\n"
+"}\0";
+
+// Corpo do fragment shader; cada permutação ganha um "#define VARIANT i" antes
+const char* fragmentShaderBody =
+"in vec2 uv;\n"
+"uniform float time;\n"
+"out vec4 FragColor;\n"
+"float noise(vec2 p)\n"
+"{\n"
+"   return fract(sin(dot(p, vec2(12.9898, 78.233) + float(VARIANT))) * 43758.5453);\n"
+"}\n"
+"void main()\n"
+"{\n"
+"   vec3 color = vec3(0.0);\n"
+"   vec2 p = uv * (4.0 + float(VARIANT % 7));\n"
+"   for (int i = 0; i < 4 + VARIANT % 5; i++) {\n"
+"       vec2 cell = floor(p), f = fract(p);\n"
+"       float n = mix(mix(noise(cell), noise(cell + vec2(1.0, 0.0)), f.x),\n"
+"                     mix(noise(cell + vec2(0.0, 1.0)), noise(cell + vec2(1.0)), f.x), f.y);\n"
+"       color += vec3(n, n * n, sqrt(n)) / float(i + 1);\n"
+"       p = mat2(0.8, 0.6, -0.6, 0.8) * p * 2.0 + time;\n"
+"   }\n"
+"#if VARIANT % 2 == 1\n"
+"   color = 1.0 - color;\n"
+"#endif\n"
+"   FragColor = vec4(color, 1.0);\n"
+"}\n";
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 256, 256);
+
+    int count = 64;
+    bool clear = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--permutations" && hasValue)
+            count = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--clear")
+            clear = true;
+    }
+
+    if (clear && !run.shaderCache.empty()) {
+        std::error_code ec;
+        std::filesystem::remove_all(run.shaderCache, ec);
+    }
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "Cache de programas");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    std::vector<std::string> fragmentSources(count);
+    for (int i = 0; i < count; i++)
+        fragmentSources[i] = "#version 400\n#define VARIANT " + std::to_string(i) + "\n" + fragmentShaderBody;
+
+    GLuint VAO;
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    std::printf("%d programas, cache: %s\n", count, run.shaderCache.empty() ? "desligado" : run.shaderCache.c_str());
+    for (int pass = 0; pass < 2; pass++) {
+        int hits = 0, misses = 0, failed = 0;
+        std::vector<GLuint> programs(count);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            ProgramCacheResult result;
+            programs[i] = loadCachedProgram(run.shaderCache, vertexShaderSource, fragmentSources[i].c_str(), NULL,
+                                            &result);
+            if (!programs[i])
+                failed++;
+            else if (result == ProgramCacheResult::Hit)
+                hits++;
+            else
+                misses++;
+            glUseProgram(programs[i]);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 3);
+        }
+        glFinish();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("passada %d: %.2f ms (%.3f ms por programa), %d do cache, %d compilados", pass + 1, ms, ms / count,
+                    hits, misses);
+        if (failed)
+            std::printf(", %d falharam", failed);
+        std::printf("\n");
+
+        glUseProgram(0);
+        for (GLuint program : programs)
+            glDeleteProgram(program);
+    }
+
+    // Limpa recursos alocados
+    glDeleteVertexArrays(1, &VAO);
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,261 @@
+/*
+ *  Benchmark do atlas + lote de sprites (Common/TextureAtlas.h e
+ *  Common/SpriteBatch.h): N sprites animados, com imagens variadas, desenhados
+ *  numa chamada só a partir de um atlas, ou (com --separate) com uma textura
+ *  por imagem e uma chamada de desenho por sprite, como seria sem atlas.
+ *
+ *  Uso: spritebatchbench [--sprites N] [--images I] [--separate] [--tex arquivo]... [opções do RunMode.h]
+ *    --sprites N  sprites por frame (padrão: 10000)
+ *    --images I   imagens geradas (círculos, anéis e xadrezes de 16 a 128 px; padrão: 48)
+ *    --separate   sem atlas: uma textura por imagem, um glDrawArraysInstanced por sprite
+ *    --tex        acrescenta uma imagem do disco (reduzida até 256 px; pode repetir)
+ *  Ex.: spritebatchbench --headless --frames 300 --sprites 100000 --profile sprites.json
+ *
+ *  Ao fim mostra o tamanho do atlas, as chamadas de desenho por frame e o tempo
+ *  médio de frame.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+#include "RunMode.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+// Imagem sintética k: círculo, anel ou xadrez, com tamanho e cor variando com k
+TextureImage makeSpriteImage(int k)
+{
+    TextureImage image;
+    int size = 16 << (k % 4);
+    image.width = size;
+    image.height = size;
+    image.pixels.resize((size_t)size * size * 4);
+    float hue = k * 0.618034f;
+    unsigned char color[3] = {(unsigned char)(127 + 127 * std::sin(6.2831853f * hue)),
+                              (unsigned char)(127 + 127 * std::sin(6.2831853f * (hue + 0.33f))),
+                              (unsigned char)(127 + 127 * std::sin(6.2831853f * (hue + 0.67f)))};
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float dx = (x + 0.5f) / size * 2.0f - 1.0f, dy = (y + 0.5f) / size * 2.0f - 1.0f;
+            float r = std::sqrt(dx * dx + dy * dy);
+            bool inside;
+            switch (k % 3) {
+            case 0:  inside = r < 1.0f; break;
+            case 1:  inside = r < 1.0f && r > 0.6f; break;
+            default: inside = ((x * 8 / size) + (y * 8 / size)) % 2 == 0; break;
+            }
+            unsigned char* p = &image.pixels[((size_t)y * size + x) * 4];
+            p[0] = color[0];
+            p[1] = color[1];
+            p[2] = color[2];
+            p[3] = inside ? 255 : 0;
+        }
+    }
+    return image;
+}
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+
+    int spriteCount = 10000;
+    int imageCount = 48;
+    bool separate = false;
+    std::vector<string> files;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sprites" && hasValue)
+            spriteCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--images" && hasValue)
+            imageCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--separate")
+            separate = true;
+        else if (arg == "--tex" && hasValue)
+            files.push_back(argv[++i]);
+    }
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "Lote de sprites");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    // Imagens: as geradas e as do disco, reduzidas à metade até caberem em 256 px
+    TextureAtlas atlas;
+    for (int k = 0; k < imageCount; k++)
+        atlas.add("gerada" + std::to_string(k), makeSpriteImage(k));
+    for (const string& path : files) {
+        TextureImage image;
+        if (!decodeTexture(path, image))
+            continue;
+        while (std::max(image.width, image.height) > 256) {
+            std::vector<unsigned char> half;
+            bcn::downsample(image.pixels, image.width, image.height, half);
+            image.pixels.swap(half);
+            image.width = std::max(1, image.width >> 1);
+            image.height = std::max(1, image.height >> 1);
+        }
+        atlas.add(path, image);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    if (!atlas.build(8192)) {
+        std::cerr << "As imagens nao cabem num atlas de 8192x8192" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    double packMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    // Com --separate cada imagem vira uma textura própria (região = textura inteira)
+    Texture atlasTexture;
+    std::vector<Texture> textures;
+    if (separate) {
+        for (size_t k = 0; k < atlas.size(); k++) {
+            const AtlasRect& rect = atlas.region(k).rect;
+            TextureImage image;
+            image.width = rect.width;
+            image.height = rect.height;
+            for (int y = 0; y < rect.height; y++) {
+                const unsigned char* row = &atlas.image().pixels[((size_t)(rect.y + y) * atlas.image().width + rect.x) * 4];
+                image.pixels.insert(image.pixels.end(), row, row + rect.width * 4);
+            }
+            TextureOptions options;
+            options.wrap = GL_CLAMP_TO_EDGE;
+            textures.push_back(Texture());
+            uploadTexture(image, textures.back(), options);
+        }
+    } else {
+        atlas.upload(atlasTexture);
+    }
+
+    SpriteBatch batch;
+    if (!batch.init()) {
+        glfwTerminate();
+        return -1;
+    }
+    batch.setTransform(glm::vec2((float)run.height / run.width, 1.0f), glm::vec2(0.0f, 0.0f));
+
+    // Posição inicial e velocidade de cada sprite (determinísticas)
+    std::vector<glm::vec4> motion(spriteCount);
+    for (int i = 0; i < spriteCount; i++) {
+        float a = i * 2.39996f, r = std::sqrt((i + 0.5f) / spriteCount);
+        motion[i] = glm::vec4(r * std::cos(a) * 1.6f, r * std::sin(a) * 0.95f, 0.3f + (i % 7) * 0.1f, (float)(i % 13));
+    }
+    float spriteSize = std::min(0.1f, 2.0f / std::sqrt((float)spriteCount));
+
+    double frameMsTotal = 0.0;
+    int measured = 0;
+    size_t drawCalls = 0;
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        auto frameStart = std::chrono::steady_clock::now();
+        float time = (float)run.frameCount / 60.0f;
+
+        // Processa entrada
+        processInput(window);
+
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        drawCalls = 0;
+        if (!separate)
+            batch.begin();
+        for (int i = 0; i < spriteCount; i++) {
+            size_t image = (size_t)i % atlas.size();
+            Sprite sprite;
+            float phase = time * motion[i].z + motion[i].w;
+            sprite.position = glm::vec2(motion[i].x + 0.05f * std::cos(phase), motion[i].y + 0.05f * std::sin(phase));
+            sprite.size = glm::vec2(spriteSize, spriteSize);
+            sprite.rotation = phase;
+            sprite.uv = separate ? glm::vec4(0.0f, 0.0f, 1.0f, 1.0f) : atlas.region(image).uv;
+            if (separate) {
+                batch.begin();
+                batch.draw(sprite);
+                batch.end(textures[image].id);
+                drawCalls++;
+            } else {
+                batch.draw(sprite);
+            }
+        }
+        if (!separate) {
+            batch.end(atlasTexture.id);
+            drawCalls++;
+        }
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+        if (run.frameCount > run.warmup) {
+            frameMsTotal += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+            measured++;
+        }
+    }
+
+    std::printf("%s: %d sprites, %zu imagens", separate ? "separado" : "atlas", spriteCount, atlas.size());
+    if (!separate)
+        std::printf(" num atlas de %dx%d (montado em %.1f ms)", atlas.image().width, atlas.image().height, packMs);
+    std::printf("\n  %zu chamadas de desenho por frame, %.3f ms por frame (media de %d)\n", drawCalls,
+                measured ? frameMsTotal / measured : 0.0, measured);
+
+    // Limpa recursos alocados
+    batch.destroy();
+    destroyTexture(atlasTexture);
+    for (Texture& texture : textures)
+        destroyTexture(texture);
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
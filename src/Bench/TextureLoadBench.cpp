@@ -0,0 +1,295 @@
+/*
+ *  Benchmark do cache de texturas (Common/TextureCache.h): pede cada imagem
+ *  várias vezes, como se vários objetos usassem a mesma textura, e mostra
+ *  quantas foram de fato decodificadas, quando cada uma ficou pronta e o pior
+ *  frame durante a carga.
+ *
+ *  Uso: textureloadbench [--tex arquivo]... [--repeat R] [--workers W] [--sync] [--compress bc1|bc3|bc7]
+ *                        [--frame-ms F] [opções do RunMode.h]
+ *    --tex      imagem a carregar (pode repetir; padrão: as de assets/)
+ *    --repeat   quantas vezes cada imagem é pedida (padrão: 8)
+ *    --workers  threads de decode do AssetLoader (padrão: núcleos - 1)
+ *    --sync     carrega tudo com loadTexture antes do loop, para comparar
+ *    --compress blocos comprimidos (TextureOptions::compression): a primeira
+ *               execução comprime e grava "<imagem>.bc7" etc.; as seguintes
+ *               só leem esses arquivos
+ *    --frame-ms duração mínima de cada frame (padrão: 16.6 no headless)
+ *  Ex.: textureloadbench --headless --frames 120 --repeat 32
+ *
+ *  Cada pedido é desenhado num quadrado da tela assim que a textura fica
+ *  pronta; pedidos repetidos usam o mesmo nome de textura. No fim mostra
+ *  também a memória de vídeo das texturas distintas.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+#include "AssetLoader.h"
+#include "RunMode.h"
+#include "TextureCache.h"
+
+const char* vertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec2 aPos;\n"
+"uniform vec4 uOffsetScale;\n"
+"out vec2 texCoord;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos * uOffsetScale.w + uOffsetScale.xy, 0.0, 1.0);\n"
+"   texCoord = aPos * 0.5 + 0.5;\n"
+"}\0";
+
+const char* fragmentShaderSource = "#version 460 core\n"
+"in vec2 texCoord;\n"
+"uniform sampler2D uTexture;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   FragColor = texture(uTexture, texCoord);\n"
+"}\0";
+
+typedef std::chrono::steady_clock Clock;
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+GLuint compileProgram()
+{
+    int success;
+    char infoLog[512];
+    GLuint shaders[2] = {glCreateShader(GL_VERTEX_SHADER), glCreateShader(GL_FRAGMENT_SHADER)};
+    const char* sources[2] = {vertexShaderSource, fragmentShaderSource};
+    GLuint program = glCreateProgram();
+    for (int i = 0; i < 2; i++) {
+        glShaderSource(shaders[i], 1, &sources[i], NULL);
+        glCompileShader(shaders[i]);
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shaders[i], 512, NULL, infoLog);
+            std::cout << "ERRO::SHADER::COMPILACAO_FALHOU\n" << infoLog << std::endl;
+        }
+        glAttachShader(program, shaders[i]);
+    }
+    glLinkProgram(program);
+    glDeleteShader(shaders[0]);
+    glDeleteShader(shaders[1]);
+    return program;
+}
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+
+    int repeat = 8;
+    int workers = 0;
+    double frameMs = run.headless ? 16.6 : 0.0;
+    bool sync = false;
+    TextureOptions options;
+    std::vector<string> files;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--tex" && hasValue)
+            files.push_back(argv[++i]);
+        else if (arg == "--repeat" && hasValue)
+            repeat = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--workers" && hasValue)
+            workers = std::atoi(argv[++i]);
+        else if (arg == "--frame-ms" && hasValue)
+            frameMs = std::atof(argv[++i]);
+        else if (arg == "--sync")
+            sync = true;
+        else if (arg == "--compress" && hasValue) {
+            string format = argv[++i];
+            options.compression = format == "bc1"   ? TextureCompression::BC1
+                                  : format == "bc3" ? TextureCompression::BC3
+                                                    : TextureCompression::BC7;
+        }
+    }
+    if (files.empty())
+        files = {"../assets/tex/pixelWall.png", "../assets/Modelos3D/Suzanne.png", "../assets/Modelos3D/SuzanneUV.png"};
+    Clock::time_point programStart = Clock::now();
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "Cache de texturas");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+    std::cout << "glTexStorage2D: " << (glextHasTextureStorage() ? "sim" : "nao (glTexImage2D por nivel)")
+              << ", formato: " << textureCompressionName(resolveTextureCompression(options.compression)) << std::endl;
+
+    GLuint shaderProgram = compileProgram();
+    GLint offsetScaleLoc = glGetUniformLocation(shaderProgram, "uOffsetScale");
+
+    // Um quadrado de -1 a 1 (TRIANGLE_STRIP)
+    GLfloat quad[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+    GLuint VAO, VBO;
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    // Os pedidos vão intercalados (a, b, c, a, b, c...), como objetos diferentes de uma cena
+    AssetLoader loader;
+    TextureCache textures(loader);
+    std::vector<std::shared_ptr<AsyncTexture>> requests;
+    if (!sync)
+        loader.start(run, window, workers);
+    for (int r = 0; r < repeat; r++) {
+        for (const string& path : files) {
+            if (sync) {
+                // Sem cache: cada pedido decodifica e envia a imagem de novo
+                std::shared_ptr<AsyncTexture> asset = std::make_shared<AsyncTexture>();
+                asset->path = path;
+                Clock::time_point start = Clock::now();
+                asset->state = loadTexture(path, asset->texture, options) ? AssetState::Ready : AssetState::Failed;
+                asset->readyMs = msSince(start);
+                requests.push_back(asset);
+            } else {
+                requests.push_back(textures.load(path, options));
+            }
+        }
+    }
+
+    int columns = std::max(1, (int)std::ceil(std::sqrt((double)requests.size())));
+    double firstFrameMs = -1.0, allReadyMs = sync ? msSince(programStart) : -1.0, worstLoadingFrameMs = 0.0;
+    int loadingFrames = 0;
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        Clock::time_point frameStart = Clock::now();
+        bool loading = allReadyMs < 0.0;
+
+        // Processa entrada
+        processInput(window);
+        loader.poll();
+
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+        glClear(GL_COLOR_BUFFER_BIT);
+        glUseProgram(shaderProgram);
+        glBindVertexArray(VAO);
+        glActiveTexture(GL_TEXTURE0);
+
+        bool allDone = true;
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (!requests[i]->ready()) {
+                allDone = allDone && requests[i]->failed();
+                continue;
+            }
+            float cell = 2.0f / columns;
+            float x = -1.0f + cell * (i % columns + 0.5f);
+            float y = 1.0f - cell * (i / columns + 0.5f);
+            glUniform4f(offsetScaleLoc, x, y, 0.0f, cell * 0.45f);
+            glBindTexture(GL_TEXTURE_2D, requests[i]->texture.id);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+        double elapsed = msSince(frameStart);
+        if (elapsed < frameMs)
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(frameMs - elapsed));
+
+        if (firstFrameMs < 0.0)
+            firstFrameMs = msSince(programStart);
+        if (loading) {
+            worstLoadingFrameMs = std::max(worstLoadingFrameMs, elapsed);
+            loadingFrames++;
+            if (allDone)
+                allReadyMs = msSince(programStart);
+        }
+    }
+    loader.stop();
+
+    std::printf("%s: primeiro frame em %.1f ms", sync ? "sincrono" : "assincrono", firstFrameMs);
+    if (allReadyMs >= 0.0)
+        std::printf(", tudo pronto em %.1f ms", allReadyMs);
+    else
+        std::printf(", carga nao terminou em %d frames", run.frameCount);
+    std::printf("\n  frames durante a carga: %d (pior: %.1f ms)\n", loadingFrames, worstLoadingFrameMs);
+    if (!sync)
+        std::printf("  %d pedidos, %zu texturas, %d decodificacoes\n", textures.requests(), textures.size(),
+                    textures.decodes());
+    size_t videoBytes = 0;
+    for (size_t i = 0; i < files.size() && i < requests.size(); i++) {
+        const AsyncTexture& t = *requests[i];
+        std::printf("  %-36s %s  %4dx%-4d %2d niveis %7.2f MB  carga %8.1f ms\n", t.path.c_str(),
+                    t.ready() ? "pronto" : "falhou", t.texture.width, t.texture.height, t.texture.levels,
+                    t.texture.bytes / (1024.0 * 1024.0), t.readyMs);
+        videoBytes += t.texture.bytes;
+    }
+    std::printf("  memoria de video (texturas distintas): %.2f MB\n", videoBytes / (1024.0 * 1024.0));
+
+    // Limpa recursos alocados
+    if (sync) {
+        for (std::shared_ptr<AsyncTexture>& t : requests)
+            destroyTexture(t->texture);
+    }
+    textures.destroy();
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteProgram(shaderProgram);
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,295 @@
+/*
+ *  Benchmark de layout de vértices: atributos intercalados num VBO (AoS) contra
+ *  um VBO por atributo (SoA), em duas cargas de trabalho:
+ *    - passada de profundidade: só a posição é lida (mesh.positionVAO), cor
+ *      desligada com glColorMask;
+ *    - sombreamento completo: posição, cor, coord. de textura e normal.
+ *
+ *  A malha é uma esfera gerada em memória (com vt e vn, como um .obj) e passa
+ *  pelo mesmo caminho do loader: buildIndexedBuffer -> optimizeMesh ->
+ *  uploadIndexedMesh com VertexStreams::Interleaved e ::Separate.
+ *
+ *  Uso: vertexlayoutbench [--tris N] [--draws D] [opções do RunMode.h]
+ *    --tris N   triângulos da esfera (padrão: 1000000)
+ *    --draws D  cópias desenhadas por passada em cada frame (padrão: 4)
+ *  Ex.: vertexlayoutbench --headless --frames 100 --size 1920x1080 --profile layout.json
+ *
+ *  Mostra a média do tempo de GPU (GpuTimer.h) de cada passada; com --profile
+ *  as séries "gpu:depth-aos", "gpu:shade-soa" etc. vão para o relatório.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLFW
+#include <GLFW/glfw3.h>
+
+//GLM
+#include <glm/glm.hpp>
+
+#include "GpuTimer.h"
+#include "MeshOptimizer.h"
+#include "ObjLoader.h"
+#include "RunMode.h"
+
+// Posição escalada e deslocada no plano (sem matrizes: z fica em [-1, 1])
+const char* depthVertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"uniform vec4 uOffsetScale;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos.xy * uOffsetScale.w + uOffsetScale.xy, aPos.z * 0.5, 1.0);\n"
+"}\0";
+
+const char* depthFragmentShaderSource = "#version 460 core\n"
+"void main()\n"
+"{\n"
+"}\0";
+
+const char* shadeVertexShaderSource = "#version 460 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"layout (location = 1) in vec3 aColor;\n"
+"layout (location = 2) in vec2 aTexCoord;\n"
+"layout (location = 3) in vec3 aNormal;\n"
+"uniform vec4 uOffsetScale;\n"
+"out vec3 ourColor;\n"
+"out vec2 texCoord;\n"
+"out vec3 normal;\n"
+"void main()\n"
+"{\n"
+"   gl_Position = vec4(aPos.xy * uOffsetScale.w + uOffsetScale.xy, aPos.z * 0.5, 1.0);\n"
+"   ourColor = aColor;\n"
+"   texCoord = aTexCoord;\n"
+"   normal = aNormal;\n"
+"}\0";
+
+const char* shadeFragmentShaderSource = "#version 460 core\n"
+"in vec3 ourColor;\n"
+"in vec2 texCoord;\n"
+"in vec3 normal;\n"
+"out vec4 FragColor;\n"
+"void main()\n"
+"{\n"
+"   float diffuse = max(dot(normalize(normal), normalize(vec3(0.4, 0.6, -0.7))), 0.0);\n"
+"   float checker = mod(floor(texCoord.x * 32.0) + floor(texCoord.y * 16.0), 2.0);\n"
+"   FragColor = vec4(ourColor * (0.2 + 0.8 * diffuse) * (0.6 + 0.4 * checker), 1.0);\n"
+"}\0";
+
+void processInput(GLFWwindow *window)
+{
+    // Fecha a janela quando ESC é pressionado
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+GLuint compileProgram(const char* vsSource, const char* fsSource)
+{
+    int success;
+    char infoLog[512];
+    GLuint shaders[2] = {glCreateShader(GL_VERTEX_SHADER), glCreateShader(GL_FRAGMENT_SHADER)};
+    const char* sources[2] = {vsSource, fsSource};
+    GLuint program = glCreateProgram();
+    for (int i = 0; i < 2; i++) {
+        glShaderSource(shaders[i], 1, &sources[i], NULL);
+        glCompileShader(shaders[i]);
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shaders[i], 512, NULL, infoLog);
+            std::cout << "ERRO::SHADER::COMPILACAO_FALHOU\n" << infoLog << std::endl;
+        }
+        glAttachShader(program, shaders[i]);
+    }
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "ERRO::PROGRAMA::LINKAGEM_FALHOU\n" << infoLog << std::endl;
+    }
+    glDeleteShader(shaders[0]);
+    glDeleteShader(shaders[1]);
+    return program;
+}
+
+// Esfera UV com ~`tris` triângulos, nos mesmos vetores que o parser preenche
+// (v, vt e vn separados, cantos v/vt/vn)
+void buildSphere(int tris, ObjData& data)
+{
+    int stacks = std::max(2, (int)std::sqrt(tris / 4.0));
+    int slices = std::max(3, tris / (2 * stacks));
+    const float kPi = 3.14159265f;
+
+    for (int i = 0; i <= stacks; i++) {
+        float phi = kPi * i / stacks;
+        for (int j = 0; j <= slices; j++) {
+            float theta = 2.0f * kPi * j / slices;
+            glm::vec3 n(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+            data.vertices.push_back(n);
+            data.normals.push_back(n);
+            data.texCoords.push_back(glm::vec2((float)j / slices, (float)i / stacks));
+        }
+    }
+
+    for (int i = 0; i < stacks; i++) {
+        for (int j = 0; j < slices; j++) {
+            int a = i * (slices + 1) + j, b = a + slices + 1;
+            int quad[6] = {a, b, a + 1, a + 1, b, b + 1};
+            for (int k = 0; k < 6; k++)
+                data.corners.push_back({quad[k], quad[k], quad[k]});
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 1280, 720);
+    int tris = 1000000;
+    int draws = 4;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--tris") == 0)
+            tris = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--draws") == 0)
+            draws = std::max(1, std::atoi(argv[++i]));
+    }
+
+    // Inicializa a GLFW
+    if (!initRunGlfw(run)) {
+        return -1;
+    }
+
+    // Configuração de contexto OpenGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // Cria a janela
+    GLFWwindow* window = createRunWindow(run, "AoS x SoA");
+    if (!window) {
+        std::cout << "Falha ao criar janela GLFW" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // Torna o contexto da janela como o contexto atual
+    glfwMakeContextCurrent(window);
+
+    // Inicializa o GLAD para carregar as funções OpenGL
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Falha ao inicializar GLAD" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
+    // Define o viewport
+    glViewport(0, 0, run.width, run.height);
+
+    GLuint depthProgram = compileProgram(depthVertexShaderSource, depthFragmentShaderSource);
+    GLuint shadeProgram = compileProgram(shadeVertexShaderSource, shadeFragmentShaderSource);
+    GLint depthOffsetScale = glGetUniformLocation(depthProgram, "uOffsetScale");
+    GLint shadeOffsetScale = glGetUniformLocation(shadeProgram, "uOffsetScale");
+
+    // Mesmo vBuffer para os dois layouts
+    ObjLoadOptions options;
+    options.texCoords = true;
+    options.normals = true;
+
+    ObjData data;
+    buildSphere(tris, data);
+    std::vector<GLfloat> vBuffer;
+    std::vector<GLuint> indices;
+    buildIndexedBuffer(data, vBuffer, indices, options);
+    optimizeMesh(vBuffer, objVertexStride(options), indices);
+
+    Mesh meshes[2];
+    const char* names[2] = {"aos", "soa"};
+    options.streams = VertexStreams::Interleaved;
+    uploadIndexedMesh(vBuffer, indices, meshes[0], options);
+    options.streams = VertexStreams::Separate;
+    uploadIndexedMesh(vBuffer, indices, meshes[1], options);
+
+    std::cout << indices.size() / 3 << " triangulos, " << meshes[0].nVertices << " vertices ("
+              << objVertexStride(options) * sizeof(GLfloat) << " bytes cada), " << draws << " copias por passada"
+              << std::endl;
+
+    GpuTimer gpuTimer(&run.profiler);
+    double totalMs[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+    int samples[2][2] = {{0, 0}, {0, 0}};
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    // Loop principal
+    while (runShouldContinue(window, run)) {
+        // Processa entrada
+        processInput(window);
+
+        for (int layout = 0; layout < 2; layout++) {
+            for (int pass = 0; pass < 2; pass++) {
+                bool depthOnly = pass == 0;
+                std::string name = std::string(depthOnly ? "depth-" : "shade-") + names[layout];
+
+                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                glColorMask(!depthOnly, !depthOnly, !depthOnly, !depthOnly);
+                glUseProgram(depthOnly ? depthProgram : shadeProgram);
+
+                {
+                    GpuTimer::Scope scope(gpuTimer, name.c_str());
+                    for (int d = 0; d < draws; d++) {
+                        float x = draws > 1 ? -0.5f + (float)d / (draws - 1) : 0.0f;
+                        glUniform4f(depthOnly ? depthOffsetScale : shadeOffsetScale, x, 0.0f, 0.0f, 0.8f);
+                        drawMesh(meshes[layout], depthOnly);
+                    }
+                }
+
+                double ms = gpuTimer.lastGpuMs(name.c_str());
+                if (ms >= 0.0 && run.frameCount >= run.warmup) {
+                    totalMs[layout][pass] += ms;
+                    samples[layout][pass]++;
+                }
+            }
+        }
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        gpuTimer.endFrame();
+
+        // Troca os buffers e verifica eventos
+        runSwapBuffers(window, run);
+        glfwPollEvents();
+    }
+
+    std::cout << "GPU (media por frame):" << std::endl;
+    for (int pass = 0; pass < 2; pass++) {
+        std::printf("  %-13s", pass == 0 ? "profundidade" : "completo");
+        for (int layout = 0; layout < 2; layout++) {
+            double avg = samples[layout][pass] ? totalMs[layout][pass] / samples[layout][pass] : -1.0;
+            std::printf("  %s %8.3f ms", names[layout], avg);
+        }
+        std::printf("\n");
+    }
+
+    // Limpa recursos alocados
+    gpuTimer.destroy();
+    destroyMesh(meshes[0]);
+    destroyMesh(meshes[1]);
+    glDeleteProgram(depthProgram);
+    glDeleteProgram(shadeProgram);
+
+    destroyRunTarget(run);
+    glfwTerminate();
+    return 0;
+}
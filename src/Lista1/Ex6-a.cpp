@@ -11,6 +11,8 @@ using namespace std;
 // GLFW
 #include <GLFW/glfw3.h>
 
+#include "RunMode.h"
+
 // Código fonte do Vertex Shader (em GLSL): ainda hardcoded
 const GLchar *vertexShaderSource = R"(
     #version 400
@@ -41,14 +43,16 @@ void processInput(GLFWwindow *window)
         glfwSetWindowTitle(window, "whatever");
 }
 
-int main()
+int main(int argc, char** argv)
 {
-	glfwInit();
+    RunConfig run = parseRunConfig(argc, argv, 800, 600);
+    if (!initRunGlfw(run))
+        return -1;
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    GLFWwindow* window = glfwCreateWindow(800, 600, "LearnOpenGL", NULL, NULL);
+    GLFWwindow* window = createRunWindow(run, "LearnOpenGL");
     if (window == NULL)
     {
     std::cout << "Failed to create GLFW window" << std::endl;
@@ -63,6 +67,9 @@ int main()
     return -1;
     } 
 
+    if (!setupRunTarget(run))
+        return -1;
+
     float vertices[] = {
         // first triangle
 		0.2, 0.2, 0.0,
@@ -83,7 +90,7 @@ int main()
     
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-    glViewport(0, 0, 800, 600);
+    glViewport(0, 0, run.width, run.height);
 
     unsigned int vertexShader;
     vertexShader = glCreateShader(GL_VERTEX_SHADER);
@@ -135,7 +142,7 @@ int main()
     // 2. use our shader program when we want to render an object
     
 
-    while(!glfwWindowShouldClose(window))
+    while (runShouldContinue(window, run))
     {
     processInput(window);
 
@@ -158,7 +165,7 @@ int main()
  
     // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
     // -------------------------------------------------------------------------------
-    glfwSwapBuffers(window);
+    runSwapBuffers(window, run);
     glfwPollEvents();   
     }
 
@@ -166,6 +173,7 @@ int main()
     glDeleteBuffers(1, &VBO);
     glDeleteProgram(shaderProgram);
 
+    destroyRunTarget(run);
     glfwTerminate();
     return 0;
 
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include <assert.h>
+#include <algorithm>
 
 
 using namespace std;
@@ -11,6 +12,11 @@ using namespace std;
 // GLFW
 #include <GLFW/glfw3.h>
 
+#include "RunMode.h"
+#include "GpuTimer.h"
+#include "ProgramCache.h"
+#include "ShaderProgram.h"
+
 // Código fonte do Vertex Shader (em GLSL): ainda hardcoded
 const GLchar *vertexShaderSource = R"(
     #version 400
@@ -63,6 +69,95 @@ const GLchar *pointFragmentShaderSource = R"(
     }
 )";
 
+// Preenchimento, contorno e pontos numa passada só: o geometry shader passa os
+// vértices do triângulo em pixels para o fragment shader e aumenta o triângulo
+// (cada lado afastado de `margin` pixels) para caber o contorno e os pontos que
+// saem dele; o fragment shader calcula a distância até os lados e os vértices
+const GLchar *overlayVertexShaderSource = R"(
+    #version 400
+    layout (location = 0) in vec3 position;
+    void main()
+    {
+        gl_Position = vec4(position.x, position.y, position.z, 1.0);
+    }
+)";
+
+const GLchar *overlayGeometryShaderSource = R"(
+    #version 400
+    layout (triangles) in;
+    layout (triangle_strip, max_vertices = 3) out;
+    uniform vec2 viewport;      // tamanho em pixels
+    uniform float margin;       // pixels acrescentados em volta do triângulo
+    flat out vec2 p0;
+    flat out vec2 p1;
+    flat out vec2 p2;
+    void main()
+    {
+        vec2 s[3];
+        for (int i = 0; i < 3; i++)
+            s[i] = (gl_in[i].gl_Position.xy / gl_in[i].gl_Position.w * 0.5 + 0.5) * viewport;
+        for (int i = 0; i < 3; i++) {
+            // Afastar os dois lados de `margin` move o vértice pela bissetriz
+            vec2 a = normalize(s[(i + 2) % 3] - s[i]);
+            vec2 b = normalize(s[(i + 1) % 3] - s[i]);
+            float sinHalf = max(sqrt(max(0.5 - 0.5 * dot(a, b), 0.0)), 0.05);
+            vec2 moved = s[i] - normalize(a + b) * margin / sinHalf;
+            p0 = s[0];
+            p1 = s[1];
+            p2 = s[2];
+            gl_Position = vec4(moved / viewport * 2.0 - 1.0, gl_in[i].gl_Position.z / gl_in[i].gl_Position.w, 1.0);
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+)";
+
+const GLchar *overlayFragmentShaderSource = R"(
+    #version 400
+    uniform vec4 fillColor;
+    uniform vec4 edgeColor;
+    uniform vec4 pointColor;
+    uniform float edgeWidth;    // pixels (o antigo glLineWidth)
+    uniform float pointSize;    // pixels (o antigo gl_PointSize)
+    flat in vec2 p0;
+    flat in vec2 p1;
+    flat in vec2 p2;
+    out vec4 color;
+
+    float segmentDistance(vec2 p, vec2 a, vec2 b)
+    {
+        vec2 ab = b - a;
+        float t = clamp(dot(p - a, ab) / dot(ab, ab), 0.0, 1.0);
+        return length(p - a - ab * t);
+    }
+
+    float side(vec2 p, vec2 a, vec2 b)
+    {
+        return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+    }
+
+    void main()
+    {
+        vec2 p = gl_FragCoord.xy;
+        float edgeDist = min(segmentDistance(p, p0, p1), min(segmentDistance(p, p1, p2), segmentDistance(p, p2, p0)));
+        float pointDist = min(distance(p, p0), min(distance(p, p1), distance(p, p2)));
+        float s0 = side(p, p0, p1), s1 = side(p, p1, p2), s2 = side(p, p2, p0);
+        bool inside = (s0 >= 0.0 && s1 >= 0.0 && s2 >= 0.0) || (s0 <= 0.0 && s1 <= 0.0 && s2 <= 0.0);
+
+        // Cobertura de cada camada (meio pixel de rampa) e composição na ordem
+        // das três passadas antigas: preenchimento, contorno por cima, pontos por cima
+        float fill = clamp(0.5 + (inside ? edgeDist : -edgeDist), 0.0, 1.0);
+        float edge = clamp(0.5 * edgeWidth + 0.5 - edgeDist, 0.0, 1.0);
+        float point = clamp(0.5 * pointSize + 0.5 - pointDist, 0.0, 1.0);
+        vec4 c = vec4(fillColor.rgb * fillColor.a, fillColor.a) * fill;
+        c = mix(c, vec4(edgeColor.rgb * edgeColor.a, edgeColor.a), edge);
+        c = mix(c, vec4(pointColor.rgb * pointColor.a, pointColor.a), point);
+        if (c.a <= 0.0)
+            discard;
+        color = c;              // alfa pré-multiplicado
+    }
+)";
+
 void processInput(GLFWwindow *window)
 {
     if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
@@ -72,52 +167,26 @@ void processInput(GLFWwindow *window)
         glfwSetWindowTitle(window, "whatever");
 }
 
-// Função auxiliar para compilar e linkar shaders
-GLuint createShaderProgram(const GLchar* vertexSource, const GLchar* fragmentSource) {
-    int success;
-    char infoLog[512];
-    
-    // Compilar vertex shader
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexSource, NULL);
-    glCompileShader(vertexShader);
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if(!success) {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-    
-    // Compilar fragment shader
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
-    glCompileShader(fragmentShader);
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if(!success) {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-    
-    // Linkar shaders
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if(!success) {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-    }
-    
-    // Limpar shaders após linkagem
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    
-    return shaderProgram;
+// Função auxiliar para compilar e linkar shaders (ou carregar o programa já
+// linkado do cache em disco, ver ProgramCache.h)
+GLuint createShaderProgram(const std::string& cacheDir, const GLchar* vertexSource, const GLchar* fragmentSource,
+                           const GLchar* geometrySource = NULL) {
+    return loadCachedProgram(cacheDir, vertexSource, fragmentSource, geometrySource);
 }
 
-int main()
+int main(int argc, char** argv)
 {
-    glfwInit();
+    RunConfig run = parseRunConfig(argc, argv, 800, 600);
+
+    // --multipass: as três passadas antigas (preenchido, GL_LINE e GL_POINTS), para comparar
+    bool multipass = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--multipass")
+            multipass = true;
+    }
+
+    if (!initRunGlfw(run))
+        return -1;
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -125,7 +194,7 @@ int main()
     // Configurar MSAA
     glfwWindowHint(GLFW_SAMPLES, 8);
 
-    GLFWwindow* window = glfwCreateWindow(800, 600, "LearnOpenGL", NULL, NULL);
+    GLFWwindow* window = createRunWindow(run, "LearnOpenGL");
     if (window == NULL)
     {
         std::cout << "Failed to create GLFW window" << std::endl;
@@ -140,6 +209,9 @@ int main()
         return -1;
     } 
 
+    if (!setupRunTarget(run))
+        return -1;
+
     // Habilitar recursos
     glEnable(GL_POINT_SMOOTH);
     glEnable(GL_LINE_SMOOTH);
@@ -168,13 +240,32 @@ int main()
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     
-    glViewport(0, 0, 800, 600);
+    glViewport(0, 0, run.width, run.height);
 
-    // Criar programas de shader
-    GLuint mainShaderProgram = createShaderProgram(vertexShaderSource, fragmentShaderSource);
-    GLuint pointShaderProgram = createShaderProgram(pointVertexShaderSource, pointFragmentShaderSource);
+    // Criar programas de shader (uniforms lidos uma vez depois do link, ver ShaderProgram.h)
+    ShaderProgram mainShader, pointShader, overlayShader;
+    mainShader.adopt(createShaderProgram(run.shaderCache, vertexShaderSource, fragmentShaderSource));
+    pointShader.adopt(createShaderProgram(run.shaderCache, pointVertexShaderSource, pointFragmentShaderSource));
+    overlayShader.adopt(createShaderProgram(run.shaderCache, overlayVertexShaderSource, overlayFragmentShaderSource,
+                                            overlayGeometryShaderSource));
+    ShaderUniformHandle<glm::vec4> mainColor = mainShader.uniform<glm::vec4>("inputColor");
+    ShaderUniformHandle<glm::vec4> pointColor = pointShader.uniform<glm::vec4>("inputColor");
 
-    while(!glfwWindowShouldClose(window))
+    // As cores e tamanhos não mudam: uniforms definidos uma vez
+    const float edgeWidth = 5.0f, pointSize = 20.0f;
+    overlayShader.use();
+    overlayShader.uniform<glm::vec2>("viewport").set(glm::vec2((float)run.width, (float)run.height));
+    overlayShader.uniform<float>("margin").set(0.5f * std::max(edgeWidth, pointSize) + 1.0f);
+    overlayShader.uniform<glm::vec4>("fillColor").set(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));   // vermelho
+    overlayShader.uniform<glm::vec4>("edgeColor").set(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));   // preto
+    overlayShader.uniform<glm::vec4>("pointColor").set(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));  // branco
+    overlayShader.uniform<float>("edgeWidth").set(edgeWidth);
+    overlayShader.uniform<float>("pointSize").set(pointSize);
+
+    // Tempo de GPU de cada passada (aparece no relatório do --profile)
+    GpuTimer gpuTimer(&run.profiler);
+
+    while (runShouldContinue(window, run))
     {
         processInput(window);
 
@@ -183,35 +274,56 @@ int main()
 
         glBindVertexArray(VAO);
 
+        // Preenchimento, contorno e pontos numa chamada
+        if (!multipass) {
+            GpuTimer::Scope pass(gpuTimer, "overlay");
+            overlayShader.use();
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            glDisable(GL_BLEND);
+        }
+
         // Desenhar triângulos preenchidos
-        glUseProgram(mainShaderProgram);
-        GLint colorLocation = glGetUniformLocation(mainShaderProgram, "inputColor");
-        
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glUniform4f(colorLocation, 1.0f, 0.0f, 0.0f, 1.0f); // vermelho
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        if (multipass) {
+            GpuTimer::Scope pass(gpuTimer, "fill");
+            mainShader.use();
+
+            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            mainColor.set(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)); // vermelho
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
 
         // Desenhar contornos
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glLineWidth(5.0);
-        glUniform4f(colorLocation, 0.0f, 0.0f, 0.0f, 1.0f); // preto
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        if (multipass) {
+            GpuTimer::Scope pass(gpuTimer, "lines");
+            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+            glLineWidth(5.0);
+            mainColor.set(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)); // preto
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
 
         // Desenhar pontos circulares usando shader específico
-        glUseProgram(pointShaderProgram);
-        colorLocation = glGetUniformLocation(pointShaderProgram, "inputColor");
-        glUniform4f(colorLocation, 1.0f, 1.0f, 1.0f, 1.0f); // branco
-        glDrawArrays(GL_POINTS, 0, 6);
+        if (multipass) {
+            GpuTimer::Scope pass(gpuTimer, "points");
+            pointShader.use();
+            pointColor.set(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)); // branco (só enviado no primeiro frame)
+            glDrawArrays(GL_POINTS, 0, 6);
+        }
 
-        glfwSwapBuffers(window);
+        gpuTimer.endFrame();
+        runSwapBuffers(window, run);
         glfwPollEvents();   
     }
 
+    gpuTimer.destroy();
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
-    glDeleteProgram(mainShaderProgram);
-    glDeleteProgram(pointShaderProgram);
+    mainShader.destroy();
+    pointShader.destroy();
+    overlayShader.destroy();
 
+    destroyRunTarget(run);
     glfwTerminate();
     return 0;
 }
@@ -9,6 +9,11 @@
 // GLFW
 #include <GLFW/glfw3.h>
 
+#include "PacManRenderer.h"
+#include "ProceduralShape.h"
+#include "RunMode.h"
+#include "VertexFormat.h"
+
 #include <math.h>
 
 const float steps = 30; 
@@ -41,10 +46,18 @@ void processInput(GLFWwindow *window)
         glfwSetWindowShouldClose(window, true);
 }
 
-int main() {
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 800, 600);
+
+    // --animate: disco inteiro com a boca abrindo e fechando no shader (PacManRenderer.h)
+    bool animate = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--animate")
+            animate = true;
+    }
+
     // Inicializa a GLFW
-    if (!glfwInit()) {
-        std::cout << "Falha ao inicializar GLFW" << std::endl;
+    if (!initRunGlfw(run)) {
         return -1;
     }
 
@@ -57,7 +70,7 @@ int main() {
     // glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 
     // Cria a janela
-    GLFWwindow* window = glfwCreateWindow(800, 600, "FraKk's cool Window", NULL, NULL);
+    GLFWwindow* window = createRunWindow(run, "FraKk's cool Window");
     if (!window) {
         std::cout << "Falha ao criar janela GLFW" << std::endl;
         glfwTerminate();
@@ -74,8 +87,14 @@ int main() {
         return -1;
     }
 
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
     // Define o viewport
-    glViewport(0, 0, 800, 600);
+    glViewport(0, 0, run.width, run.height);
 
     // Função de callback para redimensionamento da janela
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
@@ -122,82 +141,91 @@ int main() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    // Preparar dados do círculo
+    // Com --procedural o círculo sai do vertex shader (ProceduralShape.h), sem VBO
     float radius = 0.5f;
-    std::vector<float> vertices;
-    
-    // Vértice central
-    vertices.push_back(0.0f);  // posição x
-    vertices.push_back(0.0f);  // posição y
-    vertices.push_back(0.0f);  // posição z
-    vertices.push_back(1.0f);  // cor r (mudei para amarelo para o Pac-Man)
-    vertices.push_back(1.0f);  // cor g
-    vertices.push_back(0.0f);  // cor b
-    
-    // Primeiro ponto do círculo
-    float firstX = radius * sin(0);
-    float firstY = -radius * cos(0);
-    
-    float startAngle = angle * 1;  
-    float endAngle = angle * (steps - 1);  
-    
-
-    for (int i = 0; i <= steps; i++) {
-        float originalAngle = angle * i;
-        float rotatedAngle = originalAngle + rotationAngle;
+    int startTriangle = 4;
+    int endTriangle = steps - startTriangle;
+    // Ângulo (cos/sin) do ponto 0 da borda: sin/-cos girado de rotationAngle
+    // equivale a cos/sin girado de rotationAngle - pi/2
+    float offset = rotationAngle - 3.1415926f / 2.0f;
+    PacManRenderer pacman;
+    ProceduralShapes shapes;
+    std::vector<unsigned int> indices;
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+    if (animate) {
+        // A boca máxima é a fatia que os triângulos startTriangle..endTriangle deixam
+        // de fora, com a direção no meio dela
+        float mouth = 6.2831853f - angle * (endTriangle - startTriangle + 1);
+        pacman.init();
+        pacman.add(glm::vec2(0.0f, 0.0f), radius, angle * endTriangle + offset + mouth / 2.0f, glm::vec3(1.0f, 1.0f, 0.0f));
+        pacman.setMouth(mouth);
+    } else if (run.procedural) {
+        shapes.init();
+        // Mesmos pontos da borda que os triângulos startTriangle..endTriangle abaixo
+        shapes.add(proceduralArc(glm::vec2(0.0f, 0.0f), radius, angle * (startTriangle - 1) + offset,
+                                 angle * endTriangle + offset, endTriangle - startTriangle + 1,
+                                 shapeColor(glm::vec3(1.0f, 1.0f, 0.0f))));
+    } else {
+        // Preparar dados do círculo
+        std::vector<float> vertices;
 
-        float x = radius * sin(rotatedAngle);
-        float y = -radius * cos(rotatedAngle);
-        
-        vertices.push_back(x);     // posição x
-        vertices.push_back(y);     // posição y
+        // Vértice central
+        vertices.push_back(0.0f);  // posição x
+        vertices.push_back(0.0f);  // posição y
         vertices.push_back(0.0f);  // posição z
-        vertices.push_back(1.0f);  // cor r 
+        vertices.push_back(1.0f);  // cor r (mudei para amarelo para o Pac-Man)
         vertices.push_back(1.0f);  // cor g
         vertices.push_back(0.0f);  // cor b
-    }
-    
-    // Criar índices para os triângulos
-    std::vector<unsigned int> indices;
-    
 
-    
+        // Primeiro ponto do círculo
+        float firstX = radius * sin(0);
+        float firstY = -radius * cos(0);
 
-    int startTriangle = 4;  
-    int endTriangle = steps - startTriangle;
-    
-    for (int i = startTriangle; i <= endTriangle; i++) {
-        indices.push_back(0);  // Vértice central
-        indices.push_back(i);  // Vértice atual
-        indices.push_back(i + 1); // Próximo vértice
+        float startAngle = angle * 1;  
+        float endAngle = angle * (steps - 1);  
+
+        for (int i = 0; i <= steps; i++) {
+            float originalAngle = angle * i;
+            float rotatedAngle = originalAngle + rotationAngle;
+
+            float x = radius * sin(rotatedAngle);
+            float y = -radius * cos(rotatedAngle);
+
+            vertices.push_back(x);     // posição x
+            vertices.push_back(y);     // posição y
+            vertices.push_back(0.0f);  // posição z
+            vertices.push_back(1.0f);  // cor r 
+            vertices.push_back(1.0f);  // cor g
+            vertices.push_back(0.0f);  // cor b
+        }
+
+        // Criar índices para os triângulos
+        for (int i = startTriangle; i <= endTriangle; i++) {
+            indices.push_back(0);  // Vértice central
+            indices.push_back(i);  // Vértice atual
+            indices.push_back(i + 1); // Próximo vértice
+        }
+
+        // Configurar VAO, VBO e EBO
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glGenBuffers(1, &EBO);
+
+        glBindVertexArray(VAO);
+
+        // Posição e cor dos vértices (compactadas com --packed-vertices, ver VertexFormat.h)
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        uploadShapeVertices(vertices, run.packedVertices);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
     }
-    
-    // Configurar VAO, VBO e EBO
-    unsigned int VAO, VBO, EBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-    
-    glBindVertexArray(VAO);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-    
-    // Posição dos atributos
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Cor dos atributos
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
 
     // Loop principal
-    while (!glfwWindowShouldClose(window)) {
+    while (runShouldContinue(window, run)) {
         // Processa entrada
         processInput(window);
         
@@ -205,15 +233,21 @@ int main() {
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
         glClear(GL_COLOR_BUFFER_BIT);
 
-        // Usar o shader program
-        glUseProgram(shaderProgram);
-        
-        // Desenhar o círculo
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+        if (animate) {
+            pacman.draw((float)glfwGetTime());
+        } else if (run.procedural) {
+            shapes.draw();
+        } else {
+            // Usar o shader program
+            glUseProgram(shaderProgram);
+
+            // Desenhar o círculo
+            glBindVertexArray(VAO);
+            glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+        }
         
         // Troca os buffers e verifica eventos
-        glfwSwapBuffers(window);
+        runSwapBuffers(window, run);
         glfwPollEvents();
     }
 
@@ -222,8 +256,11 @@ int main() {
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &EBO);
     glDeleteProgram(shaderProgram);
+    shapes.destroy();
+    pacman.destroy();
     
     // Limpa recursos alocados
+    destroyRunTarget(run);
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
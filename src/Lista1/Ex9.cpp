@@ -36,11 +36,14 @@ using namespace std;
 // GLFW
 #include <GLFW/glfw3.h>
 
+#include "ProgramCache.h"
+#include "RunMode.h"
+
 // Protótipo da função de callback de teclado
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
 
 // Protótipos das funções
-int setupShader();
+int setupShader(const std::string& cacheDir);
 int setupGeometry();
 
 // Dimensões da janela (pode ser alterado em tempo de execução)
@@ -71,10 +74,12 @@ const GLchar *fragmentShaderSource = R"(
  )";
 
 // Função MAIN
-int main()
+int main(int argc, char** argv)
 {
 	// Inicialização da GLFW
-	glfwInit();
+	RunConfig run = parseRunConfig(argc, argv, WIDTH, HEIGHT);
+	if (!initRunGlfw(run))
+		return -1;
 
 	// Muita atenção aqui: alguns ambientes não aceitam essas configurações
 	// Você deve adaptar para a versão do OpenGL suportada por sua placa
@@ -95,7 +100,7 @@ int main()
 	// #endif
 
 	// Criação da janela GLFW
-	GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Ola Triangulo! -- Rossana", nullptr, nullptr);
+	GLFWwindow *window = createRunWindow(run, "Ola Triangulo! -- Rossana");
 	if (!window)
 	{
 		std::cerr << "Falha ao criar a janela GLFW" << std::endl;
@@ -114,6 +119,10 @@ int main()
 		return -1;
 	}
 
+	// No modo headless renderiza num FBO do tamanho pedido em --size
+	if (!setupRunTarget(run))
+		return -1;
+
 	// Obtendo as informações de versão
 	const GLubyte *renderer = glGetString(GL_RENDERER); /* get renderer string */
 	const GLubyte *version = glGetString(GL_VERSION);	/* version as a string */
@@ -126,7 +135,7 @@ int main()
 	glViewport(0, 0, width, height);
 
 	// Compilando e buildando o programa de shader
-	GLuint shaderID = setupShader();
+	GLuint shaderID = setupShader(run.shaderCache);
 
 	// Gerando um buffer simples, com a geometria de um triângulo
 	GLuint VAO = setupGeometry();
@@ -134,34 +143,11 @@ int main()
 
 	glUseProgram(shaderID); // Reseta o estado do shader para evitar problemas futuros
 
-	double prev_s = glfwGetTime();	// Define o "tempo anterior" inicial.
-	double title_countdown_s = 0.1; // Intervalo para atualizar o título da janela com o FPS.
-
 	float colorValue = 0.0;
 	// Loop da aplicação - "game loop"
-	while (!glfwWindowShouldClose(window))
+	// (o tempo de frame é medido pelo FrameProfiler: rode com --profile saida.json)
+	while (runShouldContinue(window, run))
 	{
-		// Este trecho de código é totalmente opcional: calcula e mostra a contagem do FPS na barra de título
-		{
-			double curr_s = glfwGetTime();		// Obtém o tempo atual.
-			double elapsed_s = curr_s - prev_s; // Calcula o tempo decorrido desde o último frame.
-			prev_s = curr_s;					// Atualiza o "tempo anterior" para o próximo frame.
-
-			// Exibe o FPS, mas não a cada frame, para evitar oscilações excessivas.
-			title_countdown_s -= elapsed_s;
-			if (title_countdown_s <= 0.0 && elapsed_s > 0.0)
-			{
-				double fps = 1.0 / elapsed_s; // Calcula o FPS com base no tempo decorrido.
-
-				// Cria uma string e define o FPS como título da janela.
-				char tmp[256];
-				sprintf(tmp, "Ola Triangulo! -- Rossana\tFPS %.2lf", fps);
-				glfwSetWindowTitle(window, tmp);
-
-				title_countdown_s = 0.1; // Reinicia o temporizador para atualizar o título periodicamente.
-			}
-		}
-
 		// Checa se houveram eventos de input (key pressed, mouse moved etc.) e chama as funções de callback correspondentes
 		glfwPollEvents();
 
@@ -184,10 +170,11 @@ int main()
 		// glBindVertexArray(0); // Desnecessário aqui, pois não há múltiplos VAOs
 
 		// Troca os buffers da tela
-		glfwSwapBuffers(window);
+		runSwapBuffers(window, run);
 	}
 	// Pede pra OpenGL desalocar os buffers
 	glDeleteVertexArrays(1, &VAO);
+	destroyRunTarget(run);
 	// Finaliza a execução da GLFW, limpando os recursos alocados por ela
 	glfwTerminate();
 	return 0;
@@ -206,52 +193,12 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
 //  shader simples e único neste exemplo de código
 //  O código fonte do vertex e fragment shader está nos arrays vertexShaderSource e
 //  fragmentShader source no iniçio deste arquivo
+//  Da segunda execução em diante o programa já linkado vem do cache em disco
+//  (ProgramCache.h), sem compilar de novo
 //  A função retorna o identificador do programa de shader
-int setupShader()
+int setupShader(const std::string& cacheDir)
 {
-	// Vertex shader
-	GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-	glCompileShader(vertexShader);
-	// Checando erros de compilação (exibição via log no terminal)
-	GLint success;
-	GLchar infoLog[512];
-	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n"
-				  << infoLog << std::endl;
-	}
-	// Fragment shader
-	GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-	glCompileShader(fragmentShader);
-	// Checando erros de compilação (exibição via log no terminal)
-	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n"
-				  << infoLog << std::endl;
-	}
-	// Linkando os shaders e criando o identificador do programa de shader
-	GLuint shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-	glLinkProgram(shaderProgram);
-	// Checando por erros de linkagem
-	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-	if (!success)
-	{
-		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n"
-				  << infoLog << std::endl;
-	}
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
-
-	return shaderProgram;
+	return loadCachedProgram(cacheDir, vertexShaderSource, fragmentShaderSource);
 }
 
 // Esta função está bastante harcoded - objetivo é criar os buffers que armazenam a
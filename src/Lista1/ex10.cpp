@@ -9,6 +9,8 @@ using namespace std;
 // GLFW
 #include <GLFW/glfw3.h>
 
+#include "RunMode.h"
+
 #include <math.h>
 
 // Shaders
@@ -39,10 +41,11 @@ void processInput(GLFWwindow *window)
 }
 
 
-int main() {
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 800, 600);
+
     // Inicializa a GLFW
-    if (!glfwInit()) {
-        std::cout << "Falha ao inicializar GLFW" << std::endl;
+    if (!initRunGlfw(run)) {
         return -1;
     }
 
@@ -55,7 +58,7 @@ int main() {
     // glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 
     // Cria a janela
-    GLFWwindow* window = glfwCreateWindow(800, 600, "FraKk's cool Window", NULL, NULL);
+    GLFWwindow* window = createRunWindow(run, "FraKk's cool Window");
     if (!window) {
         std::cout << "Falha ao criar janela GLFW" << std::endl;
         glfwTerminate();
@@ -72,6 +75,12 @@ int main() {
         return -1;
     }
 
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
     GLfloat carVertices[] = {
         -0.95f, -0.45f, 0.0f,
         -0.95f,  0.05f, 0.0f,
@@ -107,7 +116,7 @@ int main() {
     glEnableVertexAttribArray(0);
 
     // Define o viewport
-    glViewport(0, 0, 800, 600);
+    glViewport(0, 0, run.width, run.height);
 
     // Função de callback para redimensionamento da janela
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
@@ -160,7 +169,7 @@ int main() {
     });
 
     // Loop principal
-    while (!glfwWindowShouldClose(window)) {
+    while (runShouldContinue(window, run)) {
         // Processa entrada
         processInput(window);
 
@@ -176,11 +185,12 @@ int main() {
 
 
         // Troca os buffers e verifica eventos
-        glfwSwapBuffers(window);
+        runSwapBuffers(window, run);
         glfwPollEvents();
     }
 
     // Limpa recursos alocados
+    destroyRunTarget(run);
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
@@ -9,6 +9,10 @@
 // GLFW
 #include <GLFW/glfw3.h>
 
+#include "ProceduralShape.h"
+#include "RunMode.h"
+#include "VertexFormat.h"
+
 #include <math.h>
 
 
@@ -46,10 +50,11 @@ void processInput(GLFWwindow *window)
 
 
 
-int main() {
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 800, 600);
+
     // Inicializa a GLFW
-    if (!glfwInit()) {
-        std::cout << "Falha ao inicializar GLFW" << std::endl;
+    if (!initRunGlfw(run)) {
         return -1;
     }
 
@@ -60,7 +65,7 @@ int main() {
     
 
     // Cria a janela
-    GLFWwindow* window = glfwCreateWindow(800, 600, "FraKk's cool Window 2", NULL, NULL);
+    GLFWwindow* window = createRunWindow(run, "FraKk's cool Window 2");
     if (!window) {
         std::cout << "Falha ao criar janela GLFW" << std::endl;
         glfwTerminate();
@@ -77,8 +82,14 @@ int main() {
         return -1;
     }
 
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
     // Define o viewport
-    glViewport(0, 0, 800, 600);
+    glViewport(0, 0, run.width, run.height);
 
     // Função de callback para redimensionamento da janela
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
@@ -126,55 +137,57 @@ int main() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    std::vector<float> vertices;
-
     float startRadius = 0.9f;        // Começa quase na borda da tela
     float endRadius = 0.05f;         // Termina próximo ao centro
     float radiusStep = (startRadius - endRadius) / numPoints;
 
-    for (int i = 0; i < numPoints; i++) {
-        float currentAngle = angleStep * i;
-        float currentRadius = startRadius - (radiusStep * i);
-        
-        float x = currentRadius * cos(currentAngle);
-        float y = currentRadius * sin(currentAngle);
-        
-        // Posição
-        vertices.push_back(x);
-        vertices.push_back(y);
-        vertices.push_back(0.0f);
-        
-
-        float r =  1.0f;
-        float g =  0.0f;
-        float b =  0.0f;
-        
-        vertices.push_back(r);
-        vertices.push_back(g);
-        vertices.push_back(b);
-    }
-
-    unsigned int VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    // Com --procedural a espiral sai do vertex shader (ProceduralShape.h), sem VBO:
+    // os mesmos numPoints pontos, com o raio caindo linearmente ao longo do ângulo
+    ProceduralShapes shapes;
+    unsigned int VAO = 0, VBO = 0;
+    if (run.procedural) {
+        shapes.init();
+        shapes.add(proceduralSpiral(glm::vec2(0.0f, 0.0f), startRadius, startRadius - radiusStep * (numPoints - 1), 0.0f,
+                                    angleStep * (numPoints - 1), numPoints - 1, shapeColor(glm::vec3(1.0f, 0.0f, 0.0f))));
+    } else {
+        std::vector<float> vertices;
+
+        for (int i = 0; i < numPoints; i++) {
+            float currentAngle = angleStep * i;
+            float currentRadius = startRadius - (radiusStep * i);
+
+            float x = currentRadius * cos(currentAngle);
+            float y = currentRadius * sin(currentAngle);
+
+            // Posição
+            vertices.push_back(x);
+            vertices.push_back(y);
+            vertices.push_back(0.0f);
+
+            float r =  1.0f;
+            float g =  0.0f;
+            float b =  0.0f;
+
+            vertices.push_back(r);
+            vertices.push_back(g);
+            vertices.push_back(b);
+        }
+
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
 
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+        glBindVertexArray(VAO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+        // Posição e cor dos vértices (compactadas com --packed-vertices, ver VertexFormat.h)
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        uploadShapeVertices(vertices, run.packedVertices);
 
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
 
     // Loop principal
-    while (!glfwWindowShouldClose(window)) {
+    while (runShouldContinue(window, run)) {
         // Processa entrada
         processInput(window);
         
@@ -182,18 +195,18 @@ int main() {
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);  // Cor de fundo escura
         glClear(GL_COLOR_BUFFER_BIT);
 
-        // Usar o shader program
-        glUseProgram(shaderProgram);
-        
-
-        glBindVertexArray(VAO);
+        if (run.procedural) {
+            shapes.draw(false);
+        } else {
+            // Usar o shader program
+            glUseProgram(shaderProgram);
 
-        
-        
-        glDrawArrays(GL_LINE_STRIP, 0, numPoints);
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_LINE_STRIP, 0, numPoints);
+        }
         
         // Troca os buffers e verifica eventos
-        glfwSwapBuffers(window);
+        runSwapBuffers(window, run);
         glfwPollEvents();
     }
 
@@ -201,8 +214,10 @@ int main() {
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteProgram(shaderProgram);
+    shapes.destroy();
 
     // Limpa recursos alocados
+    destroyRunTarget(run);
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*
+ *  Comprime imagens em BC1/BC3/BC7 (Common/TextureCompress.h) e grava ao lado
+ *  de cada uma o arquivo que o loadTexture/TextureCache lê com
+ *  TextureOptions::compression ("<imagem>.bc7", por exemplo), para que nem a
+ *  primeira execução do programa precise comprimir.
+ *
+ *  Uso: texcompress [--format bc1|bc3|bc7] [--no-mips] [--no-flip] [--threads T] imagem...
+ *    --format   formato dos blocos (padrão: bc7)
+ *    --no-mips  só o nível 0 (TextureOptions::mipmaps = false)
+ *    --no-flip  mantém a ordem das linhas (TextureOptions::flipVertically = false)
+ *    --threads  threads da compressão (padrão: todos os núcleos)
+ *  Ex.: texcompress --format bc1 ../assets/tex/pixelWall.png ../assets/Modelos3D/SuzanneUV.png
+ *
+ *  As opções têm que ser as mesmas da carga: o arquivo guarda mipmaps/flip e
+ *  é ignorado (e refeito) se não corresponderem.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "TextureCache.h"
+
+int main(int argc, char** argv)
+{
+    TextureOptions options;
+    options.compression = TextureCompression::BC7;
+    int threads = resolveThreadCount(0);
+    std::vector<string> images;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc) {
+            string format = argv[++i];
+            if (format == "bc1")
+                options.compression = TextureCompression::BC1;
+            else if (format == "bc3")
+                options.compression = TextureCompression::BC3;
+            else
+                options.compression = TextureCompression::BC7;
+        } else if (arg == "--no-mips") {
+            options.mipmaps = false;
+        } else if (arg == "--no-flip") {
+            options.flipVertically = false;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else {
+            images.push_back(arg);
+        }
+    }
+    if (images.empty()) {
+        std::cerr << "Uso: texcompress [--format bc1|bc3|bc7] [--no-mips] [--no-flip] [--threads T] imagem..."
+                  << std::endl;
+        return -1;
+    }
+
+    int failed = 0;
+    for (const string& path : images) {
+        auto t0 = std::chrono::steady_clock::now();
+        TextureImage rgba;
+        if (!decodeTexture(path, rgba, options.flipVertically)) {
+            failed++;
+            continue;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        CompressedImage image;
+        compressTexture(rgba.pixels.data(), rgba.width, rgba.height, options.compression, options.mipmaps, image,
+                        threads);
+        auto t2 = std::chrono::steady_clock::now();
+
+        string cachePath = compressedTexturePath(path, options.compression);
+        if (!writeCompressedTexture(cachePath, path, image, textureCacheFlags(options))) {
+            std::cerr << "Erro ao gravar " << cachePath << std::endl;
+            failed++;
+            continue;
+        }
+
+        // RGBA8 com a mesma cadeia de mipmaps, para comparar
+        size_t rgbaBytes = 0;
+        for (int level = 0; level < image.levels; level++)
+            rgbaBytes += (size_t)image.levelWidth(level) * image.levelHeight(level) * 4;
+        std::printf("%s: %dx%d, %d niveis, %.2f MB (RGBA8: %.2f MB, %.1fx menor); decode %.0f ms, %s %.0f ms\n",
+                    cachePath.c_str(), image.width, image.height, image.levels, image.data.size() / (1024.0 * 1024.0),
+                    rgbaBytes / (1024.0 * 1024.0), (double)rgbaBytes / image.data.size(),
+                    std::chrono::duration<double, std::milli>(t1 - t0).count(),
+                    textureCompressionName(options.compression),
+                    std::chrono::duration<double, std::milli>(t2 - t1).count());
+    }
+    return failed ? 1 : 0;
+}
@@ -10,6 +10,12 @@ using namespace std;
 // GLFW
 #include <GLFW/glfw3.h>
 
+#include "CircleRenderer.h"
+#include "ProceduralShape.h"
+#include "ProgramCache.h"
+#include "RunMode.h"
+#include "VertexFormat.h"
+
 #include <math.h>
 
 // Shaders
@@ -39,41 +45,11 @@ void processInput(GLFWwindow *window)
         glfwSetWindowShouldClose(window, true);
 }
 
-// Função para criar um círculo
-std::vector<float> createCircle(float cx, float cy, float r, int num_segments, float r_color, float g_color, float b_color) {
-    std::vector<float> vertices;
-    
-    // Ponto central (com cor)
-    vertices.push_back(cx);
-    vertices.push_back(cy);
-    vertices.push_back(0.0f);
-    vertices.push_back(r_color);
-    vertices.push_back(g_color);
-    vertices.push_back(b_color);
-    
-    for (int i = 0; i <= num_segments; i++) {
-        float theta = 2.0f * 3.1415926f * float(i) / float(num_segments);
-        float x = r * cosf(theta);
-        float y = r * sinf(theta);
-        
-        // Coordenadas do vértice
-        vertices.push_back(cx + x);
-        vertices.push_back(cy + y);
-        vertices.push_back(0.0f);
-        
-        // Cor do vértice
-        vertices.push_back(r_color);
-        vertices.push_back(g_color);
-        vertices.push_back(b_color);
-    }
-    
-    return vertices;
-}
+int main(int argc, char** argv) {
+    RunConfig run = parseRunConfig(argc, argv, 800, 600);
 
-int main() {
     // Inicializa a GLFW
-    if (!glfwInit()) {
-        std::cout << "Falha ao inicializar GLFW" << std::endl;
+    if (!initRunGlfw(run)) {
         return -1;
     }
 
@@ -86,7 +62,7 @@ int main() {
     // glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 
     // Cria a janela
-    GLFWwindow* window = glfwCreateWindow(800, 600, "FraKk's cool Window", NULL, NULL);
+    GLFWwindow* window = createRunWindow(run, "FraKk's cool Window");
     if (!window) {
         std::cout << "Falha ao criar janela GLFW" << std::endl;
         glfwTerminate();
@@ -103,85 +79,38 @@ int main() {
         return -1;
     }
 
+    // No modo headless renderiza num FBO do tamanho pedido em --size
+    if (!setupRunTarget(run)) {
+        glfwTerminate();
+        return -1;
+    }
+
     // Define o viewport
-    glViewport(0, 0, 800, 600);
+    glViewport(0, 0, run.width, run.height);
 
     // Função de callback para redimensionamento da janela
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
         glViewport(0, 0, width, height);
     });
 
-    // Compilar o vertex shader
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    // Verificar erros de compilação
-    int success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        std::cout << "ERRO::SHADER::VERTEX::COMPILACAO_FALHOU\n" << infoLog << std::endl;
-    }
-
-    // Compilar o fragment shader
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-    // Verificar erros de compilação
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        std::cout << "ERRO::SHADER::FRAGMENT::COMPILACAO_FALHOU\n" << infoLog << std::endl;
+    // Compilar e linkar os shaders (da segunda execução em diante, o programa
+    // já linkado vem do cache em disco, ver ProgramCache.h)
+    unsigned int shaderProgram = loadCachedProgram(run.shaderCache, vertexShaderSource, fragmentShaderSource);
+
+    // Círculos pretos (rodas): um círculo unitário compartilhado e uma instância por roda
+    // (com --procedural, gerados no vertex shader a partir de centro e raio, ver ProceduralShape.h)
+    CircleRenderer circles;
+    ProceduralShapes shapes;
+    if (run.procedural) {
+        shapes.init();
+        shapes.add(proceduralCircle(glm::vec2(-0.55f, -0.55f), 0.15f, 36, shapeColor(glm::vec3(0.0f, 0.0f, 0.0f)))); // Círculo preto esquerdo
+        shapes.add(proceduralCircle(glm::vec2(0.55f, -0.55f), 0.15f, 36, shapeColor(glm::vec3(0.0f, 0.0f, 0.0f))));  // Círculo preto direito
+    } else {
+        circles.init(36);
+        circles.add(glm::vec2(-0.55f, -0.55f), 0.15f, glm::vec3(0.0f, 0.0f, 0.0f)); // Círculo preto esquerdo
+        circles.add(glm::vec2(0.55f, -0.55f), 0.15f, glm::vec3(0.0f, 0.0f, 0.0f));  // Círculo preto direito
     }
 
-    // Linkar os shaders
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    // Verificar erros de linkagem
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cout << "ERRO::PROGRAMA::LINKAGEM_FALHOU\n" << infoLog << std::endl;
-    }
-    
-    // Liberar shaders
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    // Círculos pretos 
-    std::vector<float> circle1 = createCircle(-0.55f, -0.55f, 0.15f, 36, 0.0f, 0.0f, 0.0f); // Círculo preto esquerdo
-    std::vector<float> circle2 = createCircle(0.55f, -0.55f, 0.15f, 36, 0.0f, 0.0f, 0.0f);  // Círculo preto direito
-
-    // VAO e VBO para os círculos
-    unsigned int circleVAO[2], circleVBO[2];
-    glGenVertexArrays(2, circleVAO);
-    glGenBuffers(2, circleVBO);
-
-    // Configurar o primeiro círculo
-    glBindVertexArray(circleVAO[0]);
-    glBindBuffer(GL_ARRAY_BUFFER, circleVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, circle1.size() * sizeof(float), &circle1[0], GL_STATIC_DRAW);
-    // Posição
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Cor
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Configurar o segundo círculo
-    glBindVertexArray(circleVAO[1]);
-    glBindBuffer(GL_ARRAY_BUFFER, circleVBO[1]);
-    glBufferData(GL_ARRAY_BUFFER, circle2.size() * sizeof(float), &circle2[0], GL_STATIC_DRAW);
-    // Posição
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Cor
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
     // Dados do carro com cores (posição xyz + cor rgb)
     GLfloat carVertices[] = {
         // Posições XYZ        // Cores RGB (vermelho)
@@ -234,21 +163,14 @@ int main() {
     glBindVertexArray(carVAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, carVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(carVertices), carVertices, GL_STATIC_DRAW);
+    // Posição e cor (compactadas com --packed-vertices, ver VertexFormat.h)
+    uploadShapeVertices(carVertices, sizeof(carVertices) / sizeof(GLfloat), run.packedVertices);
     
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, carEBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(carIndices), carIndices, GL_STATIC_DRAW);
 
-    // Posição
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    // Cor
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
     // Loop principal
-    while (!glfwWindowShouldClose(window)) {
+    while (runShouldContinue(window, run)) {
         // Processa entrada
         processInput(window);
 
@@ -256,21 +178,19 @@ int main() {
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);  // Cor de fundo
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
-
-        // Desenhar círculos primeiro (atrás do carro)
-        glBindVertexArray(circleVAO[0]);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, circle1.size() / 6);
-        
-        glBindVertexArray(circleVAO[1]);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, circle2.size() / 6);
+        // Desenhar círculos primeiro (atrás do carro), numa chamada só
+        if (run.procedural)
+            shapes.draw();
+        else
+            circles.draw();
 
         // Desenhar o carro preenchido
+        glUseProgram(shaderProgram);
         glBindVertexArray(carVAO);
         glDrawElements(GL_TRIANGLES, sizeof(carIndices)/sizeof(GLuint), GL_UNSIGNED_INT, 0);
 
         // Troca os buffers e verifica eventos
-        glfwSwapBuffers(window);
+        runSwapBuffers(window, run);
         glfwPollEvents();
     }
 
@@ -278,9 +198,10 @@ int main() {
     glDeleteVertexArrays(1, &carVAO);
     glDeleteBuffers(1, &carVBO);
     glDeleteBuffers(1, &carEBO);
-    glDeleteVertexArrays(2, circleVAO);
-    glDeleteBuffers(2, circleVBO);
+    circles.destroy();
+    shapes.destroy();
     
+    destroyRunTarget(run);
     glfwTerminate();
     return 0;
 }
\ No newline at end of file